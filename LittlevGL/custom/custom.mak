@@ -1,4 +1,5 @@
 
 $(call define-srcs, littlevgl-custom-widgets, LittlevGL/custom, \
 	tritech_logo.c \
+	monotonic_tick.c \
 )
@@ -0,0 +1,32 @@
+/**
+ * @file monotonic_tick.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#define _POSIX_C_SOURCE 199309L /*For clock_gettime with -std=c11*/
+
+#include <time.h>
+#include "monotonic_tick.h"
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get the time elapsed since an arbitrary, fixed point in the past.
+ * @return milliseconds, wraps around like the LittlevGL tick
+ */
+uint32_t monotonic_tick_get(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    /*Calculate in 64 bits, the result is truncated to the 32 bit tick*/
+    uint64_t ms = (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+
+    return (uint32_t)ms;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file monotonic_tick.h
+ *
+ */
+
+#ifndef MONOTONIC_TICK_H
+#define MONOTONIC_TICK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the time elapsed since an arbitrary, fixed point in the past.
+ * Used as LittlevGL tick source (LV_TICK_CUSTOM_SYS_TIME_EXPR).
+ * Based on CLOCK_MONOTONIC, so it isn't affected by changes of the system
+ * time and doesn't depend on a thread periodically calling `lv_tick_inc`.
+ * @return milliseconds, wraps around like the LittlevGL tick
+ */
+uint32_t monotonic_tick_get(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*MONOTONIC_TICK_H*/
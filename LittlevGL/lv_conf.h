@@ -28,8 +28,11 @@
  * - 8:  RGB233
  * - 16: RGB565
  * - 32: ARGB8888
+ * Can be set by the compiler, the tests build the drawing kernels for several depths
  */
+#ifndef LV_COLOR_DEPTH
 #define LV_COLOR_DEPTH     16
+#endif
 
 /* Swap the 2 bytes of RGB565 color.
  * Useful if the display has a 8 bit interface (e.g. SPI)*/
@@ -50,6 +53,46 @@
  * Can be changed in the display driver (`lv_disp_drv_t`).*/
 #define LV_DISP_DEF_REFR_PERIOD      30      /*[ms]*/
 
+/* Number of threads rendering the invalidated areas, in horizontal bands.
+ * 1: render in the task handler thread only. > 1: requires POSIX threads and `LV_USE_GROUP 0`.
+ * Keep 1 until the threaded rendering is validated on the target*/
+#define LV_REFR_THREADS              1
+
+/* Minimal height of a band. Areas with fewer rows are rendered by fewer threads*/
+#define LV_REFR_MIN_BAND_ROWS        16
+
+/* Extra pixels worth refreshing to save refreshing one more invalidated area.
+ * Nearby areas are joined if their bounding box is at most this much larger than they are.
+ * Default of `area_cost` in the display drivers*/
+#define LV_REFR_AREA_COST            1024
+
+/* 1: Don't draw the parts of objects hidden by opaque younger siblings*/
+#define LV_REFR_CULL                 1
+
+/* Size of the pool for the layers of cached objects in bytes (see `lv_obj_set_layer_cache`).
+ * 0: disable the layer cache*/
+#define LV_LAYER_CACHE_SIZE          (64U * 1024U)
+
+/* Number of objects moved between two refreshes whose pixels are copied on the display
+ * instead of redrawn (needs `copy_cb` in the display driver, or true double buffering).
+ * 0: always redraw*/
+#define LV_REFR_MOVE_CNT             4
+
+/* 1: Blend and fill with the vector instructions of the CPU (NEON on ARM, SSE2 on x86).
+ * Only for 16 bit (not swapped) and 32 bit colors*/
+#define LV_DRAW_SIMD                 1
+
+/* Number of rounded corner masks to cache per rendering thread (0: no caching).
+ * Solid rectangles and borders with a radius up to `LV_DRAW_CORNER_CACHE_MAX_R`
+ * and shadows with `radius + shadow width` up to it draw their corners from
+ * the cached masks instead of calculating circles and blurs.
+ * A mask takes about (2 * (radius + shadow width) + 19)^2 * 9 / 8 bytes.
+ * Can be set by the compiler, the tests draw without the cache as reference*/
+#ifndef LV_DRAW_CORNER_CACHE_CNT
+#define LV_DRAW_CORNER_CACHE_CNT     8
+#endif
+#define LV_DRAW_CORNER_CACHE_MAX_R   32
+
 /* Dot Per Inch: used to initialize default sizes.
  * E.g. a button with width = LV_DPI / 2 -> half inch wide
  * (Not so important, you can adjust it to modify default sizes and spaces)*/
@@ -199,10 +242,10 @@ typedef void * lv_img_decoder_user_data_t;
 
 /* 1: use a custom tick source.
  * It removes the need to manually update the tick with `lv_tick_inc`) */
-#define LV_TICK_CUSTOM     0
+#define LV_TICK_CUSTOM     1
 #if LV_TICK_CUSTOM == 1
-#define LV_TICK_CUSTOM_INCLUDE  "something.h"       /*Header for the sys time function*/
-#define LV_TICK_CUSTOM_SYS_TIME_EXPR (millis())     /*Expression evaluating to current systime in ms*/
+#define LV_TICK_CUSTOM_INCLUDE  "custom/monotonic_tick.h"   /*Header for the sys time function*/
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR (monotonic_tick_get()) /*Expression evaluating to current systime in ms*/
 #endif   /*LV_TICK_CUSTOM*/
 
 typedef void * lv_disp_drv_user_data_t;             /*Type of user data in the display driver*/
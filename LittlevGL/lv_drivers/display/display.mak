@@ -1,6 +1,7 @@
 
 $(call define-srcs, littlevgl-lv_drivers-display, LittlevGL/lv_drivers/display, \
 	fbdev.c \
+	headless.c \
 	monitor.c \
 	R61581.c \
 	SSD1963.c \
@@ -6,17 +6,22 @@
 /*********************
  *      INCLUDES
  *********************/
+#define _POSIX_C_SOURCE 200809L /*For pthread with -std=c11*/
 #include "fbdev.h"
 #if USE_FBDEV
 
 #include <stdlib.h>
+#include <stdbool.h>
 #include <unistd.h>
 #include <stddef.h>
 #include <stdio.h>
+#include <string.h>
 #include <fcntl.h>
 #include <linux/fb.h>
+#include <linux/kd.h>
 #include <sys/mman.h>
 #include <sys/ioctl.h>
+#include <pthread.h>
 
 /*********************
  *      DEFINES
@@ -25,22 +30,68 @@
 #define FBDEV_PATH  "/dev/fb0"
 #endif
 
+#ifndef FBDEV_TTY_PATH
+#define FBDEV_TTY_PATH  "/dev/tty0"
+#endif
+
+#ifndef FBDEV_CURSOR_BLINK_PATH
+#define FBDEV_CURSOR_BLINK_PATH  "/sys/class/graphics/fbcon/cursor_blink"
+#endif
+
+#ifndef FBDEV_ASYNC_FLUSH
+#define FBDEV_ASYNC_FLUSH  0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+/*An area to copy to the framebuffer by the flush thread*/
+typedef struct
+{
+    lv_disp_drv_t * drv;
+    lv_area_t area;
+    lv_color_t * color_p;
+} flush_job_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void console_init(void);
+static void console_restore(void);
+static void double_buf_init(void);
+static void double_buf_flip(const void * buf);
+static void copy_area(const lv_area_t * area, lv_color_t * color_p);
+#if FBDEV_ASYNC_FLUSH
+static void flush_thread_start(void);
+static void flush_thread_stop(void);
+static void * flush_thread_main(void * arg);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static struct fb_var_screeninfo vinfo;
+static struct fb_var_screeninfo vinfo_old;
 static struct fb_fix_screeninfo finfo;
 static char * fbp = 0;
 static long int screensize = 0;
-static int fbfd = 0;
+static long int mapsize = 0;
+static int fbfd = -1;
+static bool double_buf = false;
+static bool wait_vsync = true;
+static int ttyfd = -1;
+static int tty_old_mode = KD_TEXT;
+static char cursor_blink_old = 0;
+#if FBDEV_ASYNC_FLUSH
+static pthread_t flush_thread;
+static bool flush_thread_running = false;
+static pthread_mutex_t flush_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t flush_start = PTHREAD_COND_INITIALIZER; /*Signaled when a job is posted*/
+static pthread_cond_t flush_done = PTHREAD_COND_INITIALIZER;  /*Signaled when a job is ready*/
+static flush_job_t flush_job;
+static bool flush_pending = false;
+static bool flush_stop = false;
+#endif
 
 /**********************
  *      MACROS
@@ -52,6 +103,9 @@ static int fbfd = 0;
 
 void fbdev_init(void)
 {
+    // Keep the console from drawing on top of the graphics
+    console_init();
+
     // Open the file for reading and writing
     fbfd = open(FBDEV_PATH, O_RDWR);
     if(fbfd == -1) {
@@ -74,22 +128,76 @@ void fbdev_init(void)
 
     printf("%dx%d, %dbpp\n", vinfo.xres, vinfo.yres, vinfo.bits_per_pixel);
 
+    // Try to get room for two screens, restored at exit
+    vinfo_old = vinfo;
+    double_buf_init();
+
     // Figure out the size of the screen in bytes
     screensize =  finfo.line_length * vinfo.yres;
+    mapsize = double_buf ? 2 * screensize : screensize;
 
     // Map the device to memory
-    fbp = (char *)mmap(0, screensize, PROT_READ | PROT_WRITE, MAP_SHARED, fbfd, 0);
+    fbp = (char *)mmap(0, mapsize, PROT_READ | PROT_WRITE, MAP_SHARED, fbfd, 0);
     if((intptr_t)fbp == -1) {
         perror("Error: failed to map framebuffer device to memory");
+        fbp = NULL;
         return;
     }
     printf("The framebuffer device was mapped to memory successfully.\n");
 
+#if FBDEV_ASYNC_FLUSH
+    // Panning is cheap, only copying a draw buffer is worth a thread
+    if(!double_buf) flush_thread_start();
+#endif
 }
 
 void fbdev_exit(void)
 {
-    close(fbfd);
+#if FBDEV_ASYNC_FLUSH
+    flush_thread_stop();
+#endif
+
+    if(fbp != NULL) {
+        munmap(fbp, mapsize);
+        fbp = NULL;
+    }
+
+    if(fbfd != -1) {
+        // Show the first screen and give back the memory used for the second
+        if(double_buf && ioctl(fbfd, FBIOPUT_VSCREENINFO, &vinfo_old) == -1) {
+            perror("Error: cannot restore variable information");
+        }
+        double_buf = false;
+
+        close(fbfd);
+        fbfd = -1;
+    }
+
+    console_restore();
+}
+
+/**
+ * Get the two screen sized buffers of a double buffered framebuffer.
+ * LittlevGL can render directly into them as true double buffer, then
+ * `fbdev_flush` only pans the display to the rendered buffer.
+ * @param hor_res horizontal resolution of the display driver
+ * @param ver_res vertical resolution of the display driver
+ * @param buf1 store the address of the first buffer here
+ * @param buf2 store the address of the second buffer here
+ * @return true: the buffers are valid; false: not possible, a separate draw buffer is needed
+ */
+bool fbdev_get_double_buf(lv_coord_t hor_res, lv_coord_t ver_res, void ** buf1, void ** buf2)
+{
+    if(fbp == NULL || !double_buf ||
+            vinfo.xres != (uint32_t)hor_res ||
+            vinfo.yres != (uint32_t)ver_res) {
+        return false;
+    }
+
+    *buf1 = fbp;
+    *buf2 = fbp + screensize;
+
+    return true;
 }
 
 /**
@@ -99,13 +207,132 @@ void fbdev_exit(void)
  * @param color_p an array of pixel to copy to the `area` part of the screen
  */
 void fbdev_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    /*True double buffered: `color_p` is one of the screens, just show it*/
+    if(double_buf && fbp != NULL &&
+            ((char *)color_p == fbp || (char *)color_p == fbp + screensize)) {
+        double_buf_flip(color_p);
+        lv_disp_flush_ready(drv);
+        return;
+    }
+
+#if FBDEV_ASYNC_FLUSH
+    /*Let the flush thread copy the area while the next one is rendered.
+     *LittlevGL doesn't flush again until `lv_disp_flush_ready` is called*/
+    if(flush_thread_running) {
+        pthread_mutex_lock(&flush_mutex);
+        flush_job.drv = drv;
+        flush_job.area = *area;
+        flush_job.color_p = color_p;
+        flush_pending = true;
+        pthread_cond_signal(&flush_start);
+        pthread_mutex_unlock(&flush_mutex);
+        return;
+    }
+#endif
+
+    copy_area(area, color_p);
+    lv_disp_flush_ready(drv);
+}
+
+/**
+ * Wait until the area passed to `fbdev_flush` is copied to the framebuffer.
+ * Use it as `wait_cb` of the display driver to sleep instead of busy waiting.
+ * @param drv pointer to driver where this function belongs
+ */
+void fbdev_wait(lv_disp_drv_t * drv)
+{
+    (void)drv;
+
+#if FBDEV_ASYNC_FLUSH
+    pthread_mutex_lock(&flush_mutex);
+    while(flush_pending) {
+        pthread_cond_wait(&flush_done, &flush_mutex);
+    }
+    pthread_mutex_unlock(&flush_mutex);
+#endif
+}
+
+/**
+ * Copy an area of the framebuffer to an other place, for `copy_cb` of the driver.
+ * The area passed to `fbdev_flush` has to be copied already (see `fbdev_wait`).
+ * @param drv pointer to driver where this function belongs
+ * @param dest_area where to copy
+ * @param src_area what to copy, may overlap `dest_area`
+ * @return true: copied; false: not possible
+ */
+bool fbdev_copy(lv_disp_drv_t * drv, const lv_area_t * dest_area, const lv_area_t * src_area)
+{
+    (void)drv;
+
+    /*Only byte aligned pixels, in the visible part of the screen*/
+    if(fbp == NULL || vinfo.bits_per_pixel < 8 ||
+            src_area->x1 < 0 || src_area->y1 < 0 ||
+            dest_area->x1 < 0 || dest_area->y1 < 0 ||
+            src_area->x2 > (int32_t)vinfo.xres - 1 || src_area->y2 > (int32_t)vinfo.yres - 1 ||
+            dest_area->x2 > (int32_t)vinfo.xres - 1 || dest_area->y2 > (int32_t)vinfo.yres - 1) {
+        return false;
+    }
+
+    long int px_size = vinfo.bits_per_pixel / 8;
+    long int line_size = lv_area_get_width(src_area) * px_size;
+    long int src_location = (src_area->x1 + vinfo.xoffset) * px_size + (src_area->y1 + vinfo.yoffset) * finfo.line_length;
+    long int dest_location = (dest_area->x1 + vinfo.xoffset) * px_size + (dest_area->y1 + vinfo.yoffset) * finfo.line_length;
+    int32_t h = lv_area_get_height(src_area);
+    int32_t y;
+
+    /*Copy the rows in the order which doesn't overwrite the rows still to copy*/
+    if(dest_area->y1 <= src_area->y1) {
+        for(y = 0; y < h; y++) {
+            memmove(&fbp[dest_location + y * finfo.line_length], &fbp[src_location + y * finfo.line_length], line_size);
+        }
+    } else {
+        for(y = h - 1; y >= 0; y--) {
+            memmove(&fbp[dest_location + y * finfo.line_length], &fbp[src_location + y * finfo.line_length], line_size);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Wait for the vertical sync, for `vsync_cb` of the driver
+ * @param drv pointer to driver where this function belongs
+ * @return true: waited; false: not supported, or not needed as the double buffered flip waits
+ */
+bool fbdev_vsync(lv_disp_drv_t * drv)
+{
+    (void)drv;
+
+    if(fbfd == -1 || double_buf || !wait_vsync) {
+        return false;
+    }
+
+    uint32_t crtc = 0;
+    if(ioctl(fbfd, FBIO_WAITFORVSYNC, &crtc) == -1) {
+        wait_vsync = false;
+        return false;
+    }
+
+    return true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Copy a buffer to the marked area of the framebuffer
+ * @param area an area where to copy `color_p`
+ * @param color_p an array of pixel to copy to the `area` part of the screen
+ */
+static void copy_area(const lv_area_t * area, lv_color_t * color_p)
 {
     if(fbp == NULL ||
             area->x2 < 0 ||
             area->y2 < 0 ||
             area->x1 > (int32_t)vinfo.xres - 1 ||
             area->y1 > (int32_t)vinfo.yres - 1) {
-        lv_disp_flush_ready(drv);
         return;
     }
 
@@ -178,15 +405,180 @@ void fbdev_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color
 
     //May be some direct update command is required
     //ret = ioctl(state->fd, FBIO_UPDATE, (unsigned long)((uintptr_t)rect));
+}
 
-    lv_disp_flush_ready(drv);
+/**
+ * Disable the fbcon cursor blink and switch the VT to graphics mode.
+ * Done once here, so screen updates don't have to fight the console.
+ */
+static void console_init(void)
+{
+    int fd = open(FBDEV_CURSOR_BLINK_PATH, O_RDWR);
+    if(fd != -1) {
+        if(read(fd, &cursor_blink_old, 1) != 1) cursor_blink_old = 0;
+        if(write(fd, "0", 1) != 1) {
+            perror("Error: cannot disable fbcon cursor blink");
+        }
+        close(fd);
+    }
+
+    ttyfd = open(FBDEV_TTY_PATH, O_RDWR);
+    if(ttyfd == -1) {
+        perror("Error: cannot open console tty");
+        return;
+    }
+
+    if(ioctl(ttyfd, KDGETMODE, &tty_old_mode) == -1) {
+        tty_old_mode = KD_TEXT;
+    }
+    if(ioctl(ttyfd, KDSETMODE, KD_GRAPHICS) == -1) {
+        perror("Error: cannot set console to graphics mode");
+    }
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
+/**
+ * Make the virtual screen twice as high as the visible screen, if the
+ * framebuffer supports panning and its pixels can be used by LittlevGL as is.
+ */
+static void double_buf_init(void)
+{
+#if FBDEV_DOUBLE_BUF
+    if(vinfo.bits_per_pixel != LV_COLOR_DEPTH ||
+            finfo.line_length != vinfo.xres * (LV_COLOR_DEPTH / 8) ||
+            finfo.ypanstep == 0) {
+        printf("Framebuffer can't be double buffered, using a draw buffer.\n");
+        return;
+    }
+
+    struct fb_var_screeninfo v = vinfo;
+    v.yres_virtual = 2 * vinfo.yres;
+    v.yoffset = 0;
+    if(ioctl(fbfd, FBIOPUT_VSCREENINFO, &v) == -1 ||
+            ioctl(fbfd, FBIOGET_VSCREENINFO, &vinfo) == -1 ||
+            ioctl(fbfd, FBIOGET_FSCREENINFO, &finfo) == -1 ||
+            vinfo.yres_virtual < 2 * vinfo.yres ||
+            finfo.smem_len < 2 * finfo.line_length * vinfo.yres) {
+        printf("Framebuffer has no room for two screens, using a draw buffer.\n");
+        ioctl(fbfd, FBIOPUT_VSCREENINFO, &vinfo_old);
+        ioctl(fbfd, FBIOGET_VSCREENINFO, &vinfo);
+        ioctl(fbfd, FBIOGET_FSCREENINFO, &finfo);
+        return;
+    }
 
+    double_buf = true;
+    printf("Framebuffer is double buffered.\n");
 #endif
+}
+
+/**
+ * Pan the display to one of the two screens and wait until it's shown,
+ * after that the other screen is no longer scanned out and can be drawn.
+ * @param buf the first or the second screen
+ */
+static void double_buf_flip(const void * buf)
+{
+    vinfo.xoffset = 0;
+    vinfo.yoffset = ((const char *)buf == fbp) ? 0 : vinfo.yres;
+    if(ioctl(fbfd, FBIOPAN_DISPLAY, &vinfo) == -1) {
+        perror("Error: cannot pan display");
+        return;
+    }
+
+    /*Most drivers apply the pan at next vertical sync, wait for it if supported*/
+    if(wait_vsync) {
+        uint32_t crtc = 0;
+        if(ioctl(fbfd, FBIO_WAITFORVSYNC, &crtc) == -1) {
+            wait_vsync = false;
+        }
+    }
+}
+
+/**
+ * Restore the console settings changed by `console_init`
+ */
+static void console_restore(void)
+{
+    if(ttyfd != -1) {
+        if(ioctl(ttyfd, KDSETMODE, tty_old_mode) == -1) {
+            perror("Error: cannot restore console mode");
+        }
+        close(ttyfd);
+        ttyfd = -1;
+    }
 
+    if(cursor_blink_old != 0) {
+        int fd = open(FBDEV_CURSOR_BLINK_PATH, O_WRONLY);
+        if(fd != -1) {
+            if(write(fd, &cursor_blink_old, 1) != 1) {
+                perror("Error: cannot restore fbcon cursor blink");
+            }
+            close(fd);
+        }
+        cursor_blink_old = 0;
+    }
+}
 
+#if FBDEV_ASYNC_FLUSH
+/**
+ * Start the thread copying the flushed areas to the framebuffer
+ */
+static void flush_thread_start(void)
+{
+    flush_pending = false;
+    flush_stop = false;
+    if(pthread_create(&flush_thread, NULL, flush_thread_main, NULL) != 0) {
+        printf("Error: cannot create flush thread, flushing synchronously.\n");
+        return;
+    }
+    flush_thread_running = true;
+}
 
+/**
+ * Copy the last posted area, then stop and join the flush thread
+ */
+static void flush_thread_stop(void)
+{
+    if(!flush_thread_running) return;
+
+    pthread_mutex_lock(&flush_mutex);
+    flush_stop = true;
+    pthread_cond_signal(&flush_start);
+    pthread_mutex_unlock(&flush_mutex);
+
+    pthread_join(flush_thread, NULL);
+    flush_thread_running = false;
+}
+
+/**
+ * Copy each posted area to the framebuffer and report it ready to LittlevGL
+ * @param arg not used
+ * @return NULL
+ */
+static void * flush_thread_main(void * arg)
+{
+    (void)arg;
+
+    pthread_mutex_lock(&flush_mutex);
+    for(;;) {
+        while(!flush_pending && !flush_stop) {
+            pthread_cond_wait(&flush_start, &flush_mutex);
+        }
+        if(!flush_pending) break;
+
+        flush_job_t job = flush_job;
+        pthread_mutex_unlock(&flush_mutex);
+
+        copy_area(&job.area, job.color_p);
+
+        pthread_mutex_lock(&flush_mutex);
+        flush_pending = false;
+        lv_disp_flush_ready(job.drv);
+        pthread_cond_broadcast(&flush_done);
+    }
+    pthread_mutex_unlock(&flush_mutex);
+
+    return NULL;
+}
+#endif
+
+#endif
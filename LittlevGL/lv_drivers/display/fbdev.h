@@ -22,6 +22,7 @@ extern "C" {
 #if USE_FBDEV
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "lvgl/lvgl.h"
 
 /*********************
@@ -35,9 +36,52 @@ extern "C" {
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
+/**
+ * Open and map the framebuffer device.
+ * Also disables the fbcon cursor blink and sets the console to graphics mode.
+ */
 void fbdev_init(void);
+/**
+ * Close the framebuffer device and restore the console
+ */
 void fbdev_exit(void);
+/**
+ * Get the two screen sized buffers of a double buffered framebuffer
+ * @param hor_res horizontal resolution of the display driver
+ * @param ver_res vertical resolution of the display driver
+ * @param buf1 store the address of the first buffer here
+ * @param buf2 store the address of the second buffer here
+ * @return true: the buffers are valid; false: not possible, a separate draw buffer is needed
+ */
+bool fbdev_get_double_buf(lv_coord_t hor_res, lv_coord_t ver_res, void ** buf1, void ** buf2);
+/**
+ * Flush a buffer to the marked area.
+ * With `FBDEV_ASYNC_FLUSH` the copying is done by a separate thread, unless the framebuffer
+ * is double buffered, and `lv_disp_flush_ready` is called from that thread.
+ * @param drv pointer to driver where this function belongs
+ * @param area an area where to copy `color_p`
+ * @param color_p an array of pixel to copy to the `area` part of the screen
+ */
 void fbdev_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+/**
+ * Wait until the last flushed area is copied to the framebuffer, for `wait_cb` of the driver
+ * @param drv pointer to driver where this function belongs
+ */
+void fbdev_wait(lv_disp_drv_t * drv);
+/**
+ * Copy an area of the framebuffer to an other place, for `copy_cb` of the driver
+ * @param drv pointer to driver where this function belongs
+ * @param dest_area where to copy
+ * @param src_area what to copy, may overlap `dest_area`
+ * @return true: copied; false: not possible
+ */
+bool fbdev_copy(lv_disp_drv_t * drv, const lv_area_t * dest_area, const lv_area_t * src_area);
+/**
+ * Wait for the vertical sync, for `vsync_cb` of the driver
+ * @param drv pointer to driver where this function belongs
+ * @return true: waited; false: not supported, or not needed as the double buffered flip waits
+ */
+bool fbdev_vsync(lv_disp_drv_t * drv);
 
 
 /**********************
@@ -0,0 +1,200 @@
+/**
+ * @file headless.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "headless.h"
+#if USE_HEADLESS
+
+#include <stdio.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef HEADLESS_HOR_RES
+#define HEADLESS_HOR_RES    LV_HOR_RES_MAX
+#endif
+
+#ifndef HEADLESS_VER_RES
+#define HEADLESS_VER_RES    LV_VER_RES_MAX
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool area_on_fb(const lv_area_t * area);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t fb[HEADLESS_HOR_RES * HEADLESS_VER_RES];
+static headless_stats_t stats;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the in-memory frame buffer and clear the statistics
+ */
+void headless_init(void)
+{
+    memset(fb, 0, sizeof(fb));
+    memset(&stats, 0, sizeof(stats));
+}
+
+/**
+ * Flush a buffer to the marked area of the in-memory frame buffer
+ * @param drv pointer to driver where this function belongs
+ * @param area an area where to copy `color_p`
+ * @param color_p an array of pixel to copy to the `area` part of the screen
+ */
+void headless_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    if(area->x2 < 0 ||
+            area->y2 < 0 ||
+            area->x1 > HEADLESS_HOR_RES - 1 ||
+            area->y1 > HEADLESS_VER_RES - 1) {
+        lv_disp_flush_ready(drv);
+        return;
+    }
+
+    /*Truncate the area to the frame buffer*/
+    int32_t act_x1 = area->x1 < 0 ? 0 : area->x1;
+    int32_t act_y1 = area->y1 < 0 ? 0 : area->y1;
+    int32_t act_x2 = area->x2 > HEADLESS_HOR_RES - 1 ? HEADLESS_HOR_RES - 1 : area->x2;
+    int32_t act_y2 = area->y2 > HEADLESS_VER_RES - 1 ? HEADLESS_VER_RES - 1 : area->y2;
+
+    lv_coord_t w = lv_area_get_width(area);
+    int32_t y;
+
+    color_p += (act_y1 - area->y1) * w + (act_x1 - area->x1);
+    for(y = act_y1; y <= act_y2; y++) {
+        memcpy(&fb[y * HEADLESS_HOR_RES + act_x1], color_p, (act_x2 - act_x1 + 1) * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    stats.flushes++;
+    stats.flush_px += lv_area_get_size(area);
+
+    lv_disp_flush_ready(drv);
+}
+
+/**
+ * Copy an area of the in-memory frame buffer to an other place, to be used as `copy_cb`
+ * @param drv pointer to driver where this function belongs
+ * @param dest_area where to copy
+ * @param src_area what to copy, may overlap `dest_area`
+ * @return true: copied; false: an area is not on the frame buffer
+ */
+bool headless_copy(lv_disp_drv_t * drv, const lv_area_t * dest_area, const lv_area_t * src_area)
+{
+    (void) drv;      /*Unused*/
+
+    if(area_on_fb(dest_area) == false || area_on_fb(src_area) == false) return false;
+
+    uint32_t line_size = lv_area_get_width(src_area) * sizeof(lv_color_t);
+    lv_coord_t h = lv_area_get_height(src_area);
+    lv_coord_t y;
+
+    /*Copy the rows in the order which doesn't overwrite the rows still to copy*/
+    if(dest_area->y1 <= src_area->y1) {
+        for(y = 0; y < h; y++) {
+            memmove(&fb[(dest_area->y1 + y) * HEADLESS_HOR_RES + dest_area->x1],
+                    &fb[(src_area->y1 + y) * HEADLESS_HOR_RES + src_area->x1], line_size);
+        }
+    } else {
+        for(y = h - 1; y >= 0; y--) {
+            memmove(&fb[(dest_area->y1 + y) * HEADLESS_HOR_RES + dest_area->x1],
+                    &fb[(src_area->y1 + y) * HEADLESS_HOR_RES + src_area->x1], line_size);
+        }
+    }
+
+    stats.copies++;
+
+    return true;
+}
+
+/**
+ * Collect statistics of a refreshed frame, to be used as `monitor_cb`
+ * @param drv pointer to driver where this function belongs
+ * @param time time it took to render the frame [ms]
+ * @param px number of pixels rendered
+ */
+void headless_monitor(lv_disp_drv_t * drv, uint32_t time, uint32_t px)
+{
+    (void) drv;      /*Unused*/
+
+    stats.frames++;
+    stats.px += px;
+    stats.time_sum += time;
+    if(time > stats.time_max) stats.time_max = time;
+}
+
+/**
+ * Get the rendering statistics
+ * @param stats_p store the statistics here
+ */
+void headless_get_stats(headless_stats_t * stats_p)
+{
+    *stats_p = stats;
+}
+
+/**
+ * Write the in-memory frame buffer to a binary PPM (P6) image file
+ * @param path name of the file
+ * @return true: the file is written, false: error
+ */
+bool headless_dump_ppm(const char * path)
+{
+    FILE * file = fopen(path, "wb");
+    if(file == NULL) {
+        perror("Error: cannot open frame dump file");
+        return false;
+    }
+
+    fprintf(file, "P6\n%d %d\n255\n", HEADLESS_HOR_RES, HEADLESS_VER_RES);
+
+    uint32_t i;
+    for(i = 0; i < HEADLESS_HOR_RES * HEADLESS_VER_RES; i++) {
+        lv_color32_t c;
+        c.full = lv_color_to32(fb[i]);
+
+        uint8_t rgb[3] = {c.ch.red, c.ch.green, c.ch.blue};
+        fwrite(rgb, 1, sizeof(rgb), file);
+    }
+
+    bool ok = (ferror(file) == 0);
+    fclose(file);
+
+    return ok;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Check if an area is fully on the frame buffer
+ * @param area pointer to an area
+ * @return true: the area is on the frame buffer
+ */
+static bool area_on_fb(const lv_area_t * area)
+{
+    return area->x1 >= 0 && area->y1 >= 0 &&
+           area->x2 <= HEADLESS_HOR_RES - 1 && area->y2 <= HEADLESS_VER_RES - 1;
+}
+
+#endif
@@ -0,0 +1,107 @@
+/**
+ * @file headless.h
+ *
+ */
+
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_CONF_INCLUDE_SIMPLE
+#include "lv_drv_conf.h"
+#else
+#include "../../lv_drv_conf.h"
+#endif
+
+#if USE_HEADLESS
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl/lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Rendering statistics, collected by `headless_monitor`
+ */
+typedef struct
+{
+    uint32_t frames;    /*Number of refreshed frames*/
+    uint32_t flushes;   /*Number of flushed areas*/
+    uint32_t copies;    /*Number of areas copied by `headless_copy`*/
+    uint64_t px;        /*Number of refreshed pixels*/
+    uint64_t flush_px;  /*Number of pixels passed to `headless_flush`*/
+    uint32_t time_sum;  /*Sum of the frame render times [ms]*/
+    uint32_t time_max;  /*Longest frame render time [ms]*/
+} headless_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the in-memory frame buffer and clear the statistics
+ */
+void headless_init(void);
+
+/**
+ * Flush a buffer to the marked area of the in-memory frame buffer
+ * @param drv pointer to driver where this function belongs
+ * @param area an area where to copy `color_p`
+ * @param color_p an array of pixel to copy to the `area` part of the screen
+ */
+void headless_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+
+/**
+ * Copy an area of the in-memory frame buffer to an other place, to be used as `copy_cb`
+ * @param drv pointer to driver where this function belongs
+ * @param dest_area where to copy
+ * @param src_area what to copy, may overlap `dest_area`
+ * @return true: copied; false: an area is not on the frame buffer
+ */
+bool headless_copy(lv_disp_drv_t * drv, const lv_area_t * dest_area, const lv_area_t * src_area);
+
+/**
+ * Collect statistics of a refreshed frame, to be used as `monitor_cb`
+ * @param drv pointer to driver where this function belongs
+ * @param time time it took to render the frame [ms]
+ * @param px number of pixels rendered
+ */
+void headless_monitor(lv_disp_drv_t * drv, uint32_t time, uint32_t px);
+
+/**
+ * Get the rendering statistics
+ * @param stats_p store the statistics here
+ */
+void headless_get_stats(headless_stats_t * stats_p);
+
+/**
+ * Write the in-memory frame buffer to a binary PPM (P6) image file
+ * @param path name of the file
+ * @return true: the file is written, false: error
+ */
+bool headless_dump_ppm(const char * path);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif  /*USE_HEADLESS*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*HEADLESS_H*/
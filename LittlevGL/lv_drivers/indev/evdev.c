@@ -206,6 +206,16 @@ bool evdev_read(lv_indev_drv_t * drv, lv_indev_data_t * data)
     return false;
 }
 
+/**
+ * Get the file descriptor of the evdev device
+ * Can be used to wait (e.g. with `poll`) for new input instead of reading periodically.
+ * @return the file descriptor or -1 if the device is not opened
+ */
+int evdev_get_fd(void)
+{
+    return evdev_fd;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
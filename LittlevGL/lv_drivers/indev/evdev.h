@@ -55,6 +55,12 @@ bool evdev_set_file(char* dev_name);
  * @return false: because the points are not buffered, so no more data to be read
  */
 bool evdev_read(lv_indev_drv_t * drv, lv_indev_data_t * data);
+/**
+ * Get the file descriptor of the evdev device
+ * Can be used to wait (e.g. with `poll`) for new input instead of reading periodically.
+ * @return the file descriptor or -1 if the device is not opened
+ */
+int evdev_get_fd(void);
 
 
 /**********************
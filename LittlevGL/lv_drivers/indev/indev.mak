@@ -7,4 +7,5 @@ $(call define-srcs, littlevgl-lv_drivers-indev, LittlevGL/lv_drivers/indev, \
 	evdev.c \
 	libinput.c \
 	XPT2046.c \
+	touch_script.c \
 )
@@ -0,0 +1,105 @@
+/**
+ * @file touch_script.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "touch_script.h"
+#if USE_TOUCH_SCRIPT
+
+#include "lvgl/src/lv_hal/lv_hal_tick.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const touch_script_point_t * script;
+static uint32_t script_cnt;
+static uint32_t script_idx;
+static uint32_t script_start;
+static bool script_started;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Set the script to play. The script is started by the first read.
+ * @param points the touches, sorted by time. Must be valid while played.
+ * @param cnt number of touches
+ */
+void touch_script_set(const touch_script_point_t * points, uint32_t cnt)
+{
+    script = points;
+    script_cnt = cnt;
+    script_idx = 0;
+    script_started = false;
+}
+
+/**
+ * Get the scripted position and state of the touch
+ * @param drv pointer to the related input device driver
+ * @param data store the touch data here
+ * @return false: because the points are not buffered, so no more data to be read
+ */
+bool touch_script_read(lv_indev_drv_t * drv, lv_indev_data_t * data)
+{
+    (void) drv;      /*Unused*/
+
+    if(script == NULL || script_cnt == 0) {
+        data->point.x = 0;
+        data->point.y = 0;
+        data->state = LV_INDEV_STATE_REL;
+        return false;
+    }
+
+    if(!script_started) {
+        script_start = lv_tick_get();
+        script_started = true;
+    }
+
+    /*Skip to the newest point that is due*/
+    uint32_t elaps = lv_tick_elaps(script_start);
+    while(script_idx + 1 < script_cnt && script[script_idx + 1].time <= elaps) {
+        script_idx++;
+    }
+
+    const touch_script_point_t * point = &script[script_idx];
+    data->point.x = point->x;
+    data->point.y = point->y;
+    data->state = (point->time <= elaps && point->pressed) ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+
+    return false;
+}
+
+/**
+ * Check if the whole script has been played
+ * @return true: the last point is reported
+ */
+bool touch_script_done(void)
+{
+    return script_started && (script_idx + 1 >= script_cnt);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#endif
@@ -0,0 +1,82 @@
+/**
+ * @file touch_script.h
+ *
+ */
+
+#ifndef TOUCH_SCRIPT_H
+#define TOUCH_SCRIPT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_CONF_INCLUDE_SIMPLE
+#include "lv_drv_conf.h"
+#else
+#include "../../lv_drv_conf.h"
+#endif
+
+#if USE_TOUCH_SCRIPT
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl/src/lv_hal/lv_hal_indev.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A touch in the script. It's reported from `time` until the time of the next point.
+ */
+typedef struct
+{
+    uint32_t time;      /*Time since the first read [ms]*/
+    lv_coord_t x;
+    lv_coord_t y;
+    bool pressed;
+} touch_script_point_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Set the script to play. The script is started by the first read.
+ * @param points the touches, sorted by time. Must be valid while played.
+ * @param cnt number of touches
+ */
+void touch_script_set(const touch_script_point_t * points, uint32_t cnt);
+
+/**
+ * Get the scripted position and state of the touch
+ * @param drv pointer to the related input device driver
+ * @param data store the touch data here
+ * @return false: because the points are not buffered, so no more data to be read
+ */
+bool touch_script_read(lv_indev_drv_t * drv, lv_indev_data_t * data);
+
+/**
+ * Check if the whole script has been played
+ * @return true: the last point is reported
+ */
+bool touch_script_done(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif  /*USE_TOUCH_SCRIPT*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*TOUCH_SCRIPT_H*/
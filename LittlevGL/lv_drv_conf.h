@@ -109,6 +109,18 @@
 #  define MONITOR_DUAL            0
 #endif
 
+/*---------------------------------------------
+ *  In-memory frame buffer (for benchmarking)
+ *--------------------------------------------*/
+#ifndef USE_HEADLESS
+#  define USE_HEADLESS        1
+#endif
+
+#if USE_HEADLESS
+#  define HEADLESS_HOR_RES    LV_HOR_RES_MAX
+#  define HEADLESS_VER_RES    LV_VER_RES_MAX
+#endif
+
 /*-----------------------------------
  *  Native Windows (including mouse)
  *----------------------------------*/
@@ -192,6 +204,11 @@
 
 #if USE_FBDEV
 #  define FBDEV_PATH          "/dev/fb1"
+/*Render directly into a framebuffer twice the screen height and pan between the halves*/
+#  define FBDEV_DOUBLE_BUF    1
+/*Copy a separate draw buffer to the framebuffer in a thread, while the next part is rendered.
+ *Not verified on the hardware yet*/
+#  define FBDEV_ASYNC_FLUSH   0
 #endif
 
 /*********************
@@ -239,6 +256,17 @@
 #endif
 
 
+/*--------------------------------------------
+ * Scripted touches (for benchmarking)
+ *-------------------------------------------*/
+#ifndef USE_TOUCH_SCRIPT
+#  define USE_TOUCH_SCRIPT    1
+#endif
+
+#if USE_TOUCH_SCRIPT
+/*No settings*/
+#endif
+
 /*---------------------------------------
  * Mouse or touchpad on PC (using SDL)
  *-------------------------------------*/
@@ -61,6 +61,58 @@
 #define LV_DISP_DEF_REFR_PERIOD      30      /*[ms]*/
 #endif
 
+/* Number of threads rendering the invalidated areas, in horizontal bands.
+ * 1: render in the task handler thread only. > 1: requires POSIX threads*/
+#ifndef LV_REFR_THREADS
+#define LV_REFR_THREADS              1
+#endif
+
+/* Minimal height of a band. Areas with fewer rows are rendered by fewer threads*/
+#ifndef LV_REFR_MIN_BAND_ROWS
+#define LV_REFR_MIN_BAND_ROWS        16
+#endif
+
+/* Extra pixels worth refreshing to save refreshing one more invalidated area.
+ * Nearby areas are joined if their bounding box is at most this much larger than they are*/
+#ifndef LV_REFR_AREA_COST
+#define LV_REFR_AREA_COST            0
+#endif
+
+/* 1: Don't draw the parts of objects hidden by opaque younger siblings*/
+#ifndef LV_REFR_CULL
+#define LV_REFR_CULL                 0
+#endif
+
+/* Size of the pool for the layers of cached objects in bytes (see `lv_obj_set_layer_cache`).
+ * 0: disable the layer cache*/
+#ifndef LV_LAYER_CACHE_SIZE
+#define LV_LAYER_CACHE_SIZE          0
+#endif
+
+/* Number of objects moved between two refreshes whose pixels are copied on the display
+ * instead of redrawn (needs `copy_cb` in the display driver). 0: always redraw*/
+#ifndef LV_REFR_MOVE_CNT
+#define LV_REFR_MOVE_CNT             0
+#endif
+
+/* 1: Blend and fill with the vector instructions of the CPU (NEON on ARM, SSE2 on x86).
+ * Only for 16 bit (not swapped) and 32 bit colors*/
+#ifndef LV_DRAW_SIMD
+#define LV_DRAW_SIMD                 0
+#endif
+
+/* Number of rounded corner masks to cache per rendering thread (0: no caching).
+ * Solid rectangles and borders with a radius up to `LV_DRAW_CORNER_CACHE_MAX_R`
+ * and shadows with `radius + shadow width` up to it draw their corners from
+ * the cached masks instead of calculating circles and blurs.
+ * A mask takes about (2 * (radius + shadow width) + 19)^2 * 9 / 8 bytes*/
+#ifndef LV_DRAW_CORNER_CACHE_CNT
+#define LV_DRAW_CORNER_CACHE_CNT     0
+#endif
+#ifndef LV_DRAW_CORNER_CACHE_MAX_R
+#define LV_DRAW_CORNER_CACHE_MAX_R   20
+#endif
+
 /* Dot Per Inch: used to initialize default sizes.
  * E.g. a button with width = LV_DPI / 2 -> half inch wide
  * (Not so important, you can adjust it to modify default sizes and spaces)*/
@@ -2,6 +2,7 @@
 $(call define-srcs, littlevgl-lvgl-lvcore, LittlevGL/lvgl/src/lv_core, \
 	lv_group.c \
 	lv_indev.c \
+	lv_layer_cache.c \
 	lv_disp.c \
 	lv_obj.c \
 	lv_refr.c \
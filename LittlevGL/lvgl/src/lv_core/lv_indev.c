@@ -1078,6 +1078,7 @@ static void indev_drag(lv_indev_proc_t * state)
 
             uint16_t inv_buf_size =
                 lv_disp_get_inv_buf_size(indev_act->driver.disp); /*Get the number of currently invalidated areas*/
+            uint32_t inv_merge_cnt = lv_disp_get_inv_merge_cnt(indev_act->driver.disp);
 
             lv_coord_t prev_x     = drag_obj->coords.x1;
             lv_coord_t prev_y     = drag_obj->coords.y1;
@@ -1125,7 +1126,9 @@ static void indev_drag(lv_indev_proc_t * state)
                  * while its coordinate is not changing only the parent's size is reduced */
                 lv_coord_t act_par_w = lv_obj_get_width(lv_obj_get_parent(drag_obj));
                 lv_coord_t act_par_h = lv_obj_get_height(lv_obj_get_parent(drag_obj));
-                if(act_par_w == prev_par_w && act_par_h == prev_par_h) {
+                /*Areas merged meanwhile may hold earlier areas too, keep them*/
+                if(act_par_w == prev_par_w && act_par_h == prev_par_h &&
+                   inv_merge_cnt == lv_disp_get_inv_merge_cnt(indev_act->driver.disp)) {
                     uint16_t new_inv_buf_size = lv_disp_get_inv_buf_size(indev_act->driver.disp);
                     lv_disp_pop_from_inv_buf(indev_act->driver.disp, new_inv_buf_size - inv_buf_size);
                 }
@@ -0,0 +1,230 @@
+/**
+ * @file lv_layer_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_layer_cache.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_LAYER_CACHE_POOL_PX (LV_LAYER_CACHE_SIZE / sizeof(lv_color_t))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_LAYER_CACHE_SIZE
+static void free_buf(lv_layer_cache_entry_t * entry);
+static void inv_entry(const lv_obj_t * obj, bool changed);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_LAYER_CACHE_SIZE
+static lv_layer_cache_entry_t entries[LV_LAYER_CACHE_CNT];
+static uint16_t used_cnt;
+
+/*The layers are kept packed at the beginning of the pool, freeing one moves the ones after it*/
+static LV_ATTRIBUTE_MEM_ALIGN lv_color_t pool[LV_LAYER_CACHE_POOL_PX];
+static uint32_t pool_used; /*In pixels*/
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get a free entry for an object
+ * @param obj pointer to an object to cache
+ * @return pointer to the entry or NULL if all entries are used (or the cache is disabled)
+ */
+lv_layer_cache_entry_t * lv_layer_cache_add(lv_obj_t * obj)
+{
+#if LV_LAYER_CACHE_SIZE
+    uint16_t i;
+    for(i = 0; i < LV_LAYER_CACHE_CNT; i++) {
+        if(entries[i].obj == NULL) {
+            memset(&entries[i], 0, sizeof(lv_layer_cache_entry_t));
+            entries[i].obj = obj;
+            used_cnt++;
+            return &entries[i];
+        }
+    }
+#else
+    (void)obj; /*Unused*/
+#endif
+
+    return NULL;
+}
+
+/**
+ * Free the entry and the layer of an object
+ * @param obj pointer to a cached object
+ */
+void lv_layer_cache_remove(const lv_obj_t * obj)
+{
+#if LV_LAYER_CACHE_SIZE
+    lv_layer_cache_entry_t * entry = lv_layer_cache_find(obj);
+    if(entry == NULL) return;
+
+    free_buf(entry);
+    entry->obj = NULL;
+    used_cnt--;
+#else
+    (void)obj; /*Unused*/
+#endif
+}
+
+/**
+ * Find the entry of an object
+ * @param obj pointer to a cached object
+ * @return pointer to the entry or NULL if not found
+ */
+lv_layer_cache_entry_t * lv_layer_cache_find(const lv_obj_t * obj)
+{
+#if LV_LAYER_CACHE_SIZE
+    uint16_t i;
+    for(i = 0; i < LV_LAYER_CACHE_CNT; i++) {
+        if(entries[i].obj == obj) return &entries[i];
+    }
+#else
+    (void)obj; /*Unused*/
+#endif
+
+    return NULL;
+}
+
+/**
+ * Iterate through the used entries
+ * @param entry pointer to an entry or NULL to get the first one
+ * @return the next used entry or NULL if there are no more
+ */
+lv_layer_cache_entry_t * lv_layer_cache_get_next(lv_layer_cache_entry_t * entry)
+{
+#if LV_LAYER_CACHE_SIZE
+    if(used_cnt == 0) return NULL;
+
+    uint16_t i = entry == NULL ? 0 : (entry - entries) + 1;
+    for(; i < LV_LAYER_CACHE_CNT; i++) {
+        if(entries[i].obj != NULL) return &entries[i];
+    }
+#else
+    (void)entry; /*Unused*/
+#endif
+
+    return NULL;
+}
+
+/**
+ * Allocate the layer of an entry from the pool. A layer of other size is freed first.
+ * Layers of invalid entries are freed if the pool is full.
+ * @param entry pointer to an entry
+ * @param px_cnt size of the layer in pixels
+ * @return true: `entry->buf` has room for `px_cnt` pixels; false: the pool is too small
+ */
+bool lv_layer_cache_alloc(lv_layer_cache_entry_t * entry, uint32_t px_cnt)
+{
+#if LV_LAYER_CACHE_SIZE
+    if(entry->buf != NULL && entry->px_cnt == px_cnt) return true;
+
+    free_buf(entry);
+
+    uint16_t i;
+    for(i = 0; i < LV_LAYER_CACHE_CNT && pool_used + px_cnt > LV_LAYER_CACHE_POOL_PX; i++) {
+        if(entries[i].obj != NULL && entries[i].valid == 0) free_buf(&entries[i]);
+    }
+    if(pool_used + px_cnt > LV_LAYER_CACHE_POOL_PX) return false;
+
+    entry->buf    = &pool[pool_used];
+    entry->px_cnt = px_cnt;
+    pool_used += px_cnt;
+
+    return true;
+#else
+    (void)entry;  /*Unused*/
+    (void)px_cnt; /*Unused*/
+    return false;
+#endif
+}
+
+/**
+ * Invalidate the layers an object is drawn in: its own, its ancestors' and its children's.
+ * (The layers of the children hold the parent behind them.)
+ * @param obj pointer to an object which is changed
+ */
+void lv_layer_cache_inv(const lv_obj_t * obj)
+{
+#if LV_LAYER_CACHE_SIZE
+    if(used_cnt == 0) return;
+
+    const lv_obj_t * par = obj;
+    while(par != NULL) {
+        if(par->layer_cache) inv_entry(par, true);
+        par = lv_obj_get_parent(par);
+    }
+
+    lv_obj_t * child;
+    LV_LL_READ(obj->child_ll, child)
+    {
+        if(child->layer_cache) inv_entry(child, false);
+    }
+#else
+    (void)obj; /*Unused*/
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_LAYER_CACHE_SIZE
+/**
+ * Give back the layer of an entry to the pool
+ * @param entry pointer to an entry
+ */
+static void free_buf(lv_layer_cache_entry_t * entry)
+{
+    if(entry->buf == NULL) return;
+
+    /*Move the layers after it to keep the pool packed*/
+    lv_color_t * end = entry->buf + entry->px_cnt;
+    memmove(entry->buf, end, (&pool[pool_used] - end) * sizeof(lv_color_t));
+
+    uint16_t i;
+    for(i = 0; i < LV_LAYER_CACHE_CNT; i++) {
+        if(entries[i].buf != NULL && entries[i].buf > entry->buf) entries[i].buf -= entry->px_cnt;
+    }
+
+    pool_used -= entry->px_cnt;
+    entry->buf    = NULL;
+    entry->px_cnt = 0;
+    entry->valid  = 0;
+}
+
+/**
+ * Mark the layer of a cached object invalid
+ * @param obj pointer to a cached object
+ * @param changed true: the object itself is changed; false: only the parent behind it
+ */
+static void inv_entry(const lv_obj_t * obj, bool changed)
+{
+    lv_layer_cache_entry_t * entry = lv_layer_cache_find(obj);
+    if(entry == NULL) return;
+
+    entry->valid = 0;
+    if(changed) entry->changed = 1;
+}
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file lv_layer_cache.h
+ *
+ */
+
+#ifndef LV_LAYER_CACHE_H
+#define LV_LAYER_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#ifndef LV_LAYER_CACHE_SIZE
+#define LV_LAYER_CACHE_SIZE 0
+#endif
+
+#ifndef LV_LAYER_CACHE_CNT
+#define LV_LAYER_CACHE_CNT 16
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * An object rendered once and drawn as a color map afterwards.
+ * The layer holds the object, its children and the part of its parent behind it,
+ * so it's opaque even if the object itself is not.
+ */
+typedef struct
+{
+    lv_obj_t * obj;      /**< The cached object, NULL: the entry is free*/
+    lv_color_t * buf;    /**< The rendered layer in the pool, NULL: not allocated*/
+    uint32_t px_cnt;     /**< Size of `buf` in pixels*/
+    lv_area_t area;      /**< Coordinates of the object when it was rendered*/
+    lv_opa_t opa_scale;  /**< Opacity scale of the object when it was rendered*/
+    uint8_t valid : 1;   /**< 1: `buf` holds how the object looks now*/
+    uint8_t changed : 1; /**< 1: invalidated since the last refresh, not worth rendering yet*/
+} lv_layer_cache_entry_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get a free entry for an object
+ * @param obj pointer to an object to cache
+ * @return pointer to the entry or NULL if all entries are used (or the cache is disabled)
+ */
+lv_layer_cache_entry_t * lv_layer_cache_add(lv_obj_t * obj);
+
+/**
+ * Free the entry and the layer of an object
+ * @param obj pointer to a cached object
+ */
+void lv_layer_cache_remove(const lv_obj_t * obj);
+
+/**
+ * Find the entry of an object
+ * @param obj pointer to a cached object
+ * @return pointer to the entry or NULL if not found
+ */
+lv_layer_cache_entry_t * lv_layer_cache_find(const lv_obj_t * obj);
+
+/**
+ * Iterate through the used entries
+ * @param entry pointer to an entry or NULL to get the first one
+ * @return the next used entry or NULL if there are no more
+ */
+lv_layer_cache_entry_t * lv_layer_cache_get_next(lv_layer_cache_entry_t * entry);
+
+/**
+ * Allocate the layer of an entry from the pool. A layer of other size is freed first.
+ * Layers of invalid entries are freed if the pool is full.
+ * @param entry pointer to an entry
+ * @param px_cnt size of the layer in pixels
+ * @return true: `entry->buf` has room for `px_cnt` pixels; false: the pool is too small
+ */
+bool lv_layer_cache_alloc(lv_layer_cache_entry_t * entry, uint32_t px_cnt);
+
+/**
+ * Invalidate the layers an object is drawn in: its own, its ancestors' and its children's.
+ * (The layers of the children hold the parent behind them.)
+ * @param obj pointer to an object which is changed
+ */
+void lv_layer_cache_inv(const lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_LAYER_CACHE_H*/
@@ -9,6 +9,7 @@
 #include "lv_obj.h"
 #include "lv_indev.h"
 #include "lv_refr.h"
+#include "lv_layer_cache.h"
 #include "lv_group.h"
 #include "lv_disp.h"
 #include "../lv_themes/lv_theme.h"
@@ -202,6 +203,7 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         new_obj->opa_scale_en = 0;
         new_obj->opa_scale    = LV_OPA_COVER;
         new_obj->parent_event = 0;
+        new_obj->layer_cache  = 0;
         new_obj->reserved     = 0;
 
         new_obj->ext_attr = NULL;
@@ -286,6 +288,7 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         new_obj->opa_scale    = LV_OPA_COVER;
         new_obj->opa_scale_en = 0;
         new_obj->parent_event = 0;
+        new_obj->layer_cache  = 0;
 
         new_obj->ext_attr = NULL;
     }
@@ -405,6 +408,9 @@ lv_res_t lv_obj_del(lv_obj_t * obj)
 
     lv_event_mark_deleted(obj);
 
+    if(obj->layer_cache) lv_layer_cache_remove(obj);
+    lv_refr_move_cancel(obj);
+
     /*Remove the object from parent's children list*/
     lv_obj_t * par = lv_obj_get_parent(obj);
     if(par == NULL) { /*It is a screen*/
@@ -471,6 +477,9 @@ void lv_obj_clean(lv_obj_t * obj)
  */
 void lv_obj_invalidate(const lv_obj_t * obj)
 {
+    /*Even if not visible now, the cached layers must be updated before drawn again*/
+    lv_layer_cache_inv(obj);
+
     if(lv_obj_get_hidden(obj)) return;
 
     /*Invalidate the object only if it belongs to the 'LV_GC_ROOT(_lv_act_scr)'*/
@@ -503,6 +512,18 @@ void lv_obj_invalidate(const lv_obj_t * obj)
     }
 }
 
+/**
+ * Mark an area of an object as invalid, for objects which redraw only a part of themselves.
+ * Unlike `lv_inv_area` it invalidates the cached layers the object is drawn in too.
+ * @param obj pointer to an object
+ * @param area_p pointer to the area to redraw, in absolute coordinates
+ */
+void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area_p)
+{
+    lv_layer_cache_inv(obj);
+    lv_inv_area(lv_obj_get_disp(obj), area_p);
+}
+
 /*=====================
  * Setter functions
  *====================*/
@@ -619,8 +640,10 @@ void lv_obj_set_pos(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
      * occur without position change*/
     if(diff.x == 0 && diff.y == 0) return;
 
-    /*Invalidate the original area*/
-    lv_obj_invalidate(obj);
+    /*Copy the drawn object to the new position if possible, else invalidate the original area*/
+    bool moved = lv_refr_move(obj, diff.x, diff.y);
+    if(moved) lv_layer_cache_inv(obj);
+    else lv_obj_invalidate(obj);
 
     /*Save the original coordinates*/
     lv_area_t ori;
@@ -640,7 +663,7 @@ void lv_obj_set_pos(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     par->signal_cb(par, LV_SIGNAL_CHILD_CHG, obj);
 
     /*Invalidate the new area*/
-    lv_obj_invalidate(obj);
+    if(!moved) lv_obj_invalidate(obj);
 }
 
 /**
@@ -1178,6 +1201,30 @@ void lv_obj_set_hidden(lv_obj_t * obj, bool en)
     par->signal_cb(par, LV_SIGNAL_CHILD_CHG, obj);
 }
 
+/**
+ * Cache how an object and its children look, and draw it as a color map while they don't change.
+ * Useful for static objects which are redrawn often because objects on or next to them change.
+ * The layer is drawn only if the object is on an opaque parent, has no `ext_draw_pad` and
+ * no older sibling is under it. Requires `LV_LAYER_CACHE_SIZE > 0`.
+ * @param obj pointer to an object
+ * @param en true: cache the object; false: don't cache it and free its layer
+ */
+void lv_obj_set_layer_cache(lv_obj_t * obj, bool en)
+{
+    if(en == lv_obj_get_layer_cache(obj)) return;
+
+    if(en) {
+        if(lv_layer_cache_add(obj) == NULL) {
+            LV_LOG_WARN("lv_obj_set_layer_cache: no free layer cache entry");
+            return;
+        }
+        obj->layer_cache = 1;
+    } else {
+        lv_layer_cache_remove(obj);
+        obj->layer_cache = 0;
+    }
+}
+
 /**
  * Enable or disable the clicking of an object
  * @param obj pointer to an object
@@ -1848,6 +1895,16 @@ bool lv_obj_get_hidden(const lv_obj_t * obj)
     return obj->hidden == 0 ? false : true;
 }
 
+/**
+ * Get whether an object is drawn from a cached layer
+ * @param obj pointer to an object
+ * @return true: the object is cached
+ */
+bool lv_obj_get_layer_cache(const lv_obj_t * obj)
+{
+    return obj->layer_cache == 0 ? false : true;
+}
+
 /**
  * Get the click enable attribute of an object
  * @param obj pointer to an object
@@ -2272,6 +2329,9 @@ static void delete_children(lv_obj_t * obj)
 
     lv_event_mark_deleted(obj);
 
+    if(obj->layer_cache) lv_layer_cache_remove(obj);
+    lv_refr_move_cancel(obj);
+
     /*Remove the animations from this object*/
 #if LV_USE_ANIMATION
     lv_anim_del(obj, NULL);
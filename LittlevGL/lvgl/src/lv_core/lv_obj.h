@@ -218,7 +218,8 @@ typedef struct _lv_obj_t
     uint8_t opa_scale_en : 1;   /**< 1: opa_scale is set*/
     uint8_t parent_event : 1;   /**< 1: Send the object's events to the parent too. */
     lv_drag_dir_t drag_dir : 2; /**<  Which directions the object can be dragged in */
-    uint8_t reserved : 6;       /**<  Reserved for future use*/
+    uint8_t layer_cache : 1;    /**< 1: Draw from a cached layer while not changed, see `lv_layer_cache.h`*/
+    uint8_t reserved : 5;       /**<  Reserved for future use*/
     uint8_t protect;            /**< Automatically happening actions can be prevented. 'OR'ed values from
                                    `lv_protect_t`*/
     lv_opa_t opa_scale;         /**< Scale down the opacity by this factor. Effects all children as well*/
@@ -297,6 +298,14 @@ void lv_obj_clean(lv_obj_t * obj);
  */
 void lv_obj_invalidate(const lv_obj_t * obj);
 
+/**
+ * Mark an area of an object as invalid, for objects which redraw only a part of themselves.
+ * Unlike `lv_inv_area` it invalidates the cached layers the object is drawn in too.
+ * @param obj pointer to an object
+ * @param area_p pointer to the area to redraw, in absolute coordinates
+ */
+void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area_p);
+
 /*=====================
  * Setter functions
  *====================*/
@@ -451,6 +460,16 @@ void lv_obj_report_style_mod(lv_style_t * style);
  */
 void lv_obj_set_hidden(lv_obj_t * obj, bool en);
 
+/**
+ * Cache how an object and its children look, and draw it as a color map while they don't change.
+ * Useful for static objects which are redrawn often because objects on or next to them change.
+ * The layer is drawn only if the object is on an opaque parent, has no `ext_draw_pad` and
+ * no older sibling is under it. Requires `LV_LAYER_CACHE_SIZE > 0`.
+ * @param obj pointer to an object
+ * @param en true: cache the object; false: don't cache it and free its layer
+ */
+void lv_obj_set_layer_cache(lv_obj_t * obj, bool en);
+
 /**
  * Enable or disable the clicking of an object
  * @param obj pointer to an object
@@ -792,6 +811,13 @@ const lv_style_t * lv_obj_get_style(const lv_obj_t * obj);
  */
 bool lv_obj_get_hidden(const lv_obj_t * obj);
 
+/**
+ * Get whether an object is drawn from a cached layer
+ * @param obj pointer to an object
+ * @return true: the object is cached
+ */
+bool lv_obj_get_layer_cache(const lv_obj_t * obj);
+
 /**
  * Get the click enable attribute of an object
  * @param obj pointer to an object
@@ -6,8 +6,11 @@
 /*********************
  *      INCLUDES
  *********************/
+#define _POSIX_C_SOURCE 200809L /*For sysconf*/
 #include <stddef.h>
+#include <string.h>
 #include "lv_refr.h"
+#include "lv_layer_cache.h"
 #include "lv_disp.h"
 #include "../lv_hal/lv_hal_tick.h"
 #include "../lv_hal/lv_hal_disp.h"
@@ -20,33 +23,114 @@
 #include LV_GC_INCLUDE
 #endif /* LV_ENABLE_GC */
 
+#if LV_REFR_THREADS > 1
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+#endif
+
 /*********************
  *      DEFINES
  *********************/
 /* Draw translucent random colored areas on the invalidated (redrawn) areas*/
 #define MASK_AREA_DEBUG 0
 
+/*Refresh at least in every this many periods, no matter how long the frames take*/
+#define LV_REFR_DIV_MAX 4
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_REFR_THREADS > 1
+/*Threads rendering the bands of an area together with the task handler thread*/
+typedef struct
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t start;         /*Signaled when new bands are ready*/
+    pthread_cond_t done;          /*Signaled when the last band is rendered*/
+    uint32_t gen;                 /*Incremented for each set of bands*/
+    uint32_t band_cnt;            /*Number of bands in the current set*/
+    uint32_t pending;             /*Bands not yet rendered by the workers*/
+    lv_area_t bands[LV_REFR_THREADS];
+    pthread_t threads[LV_REFR_THREADS]; /*Workers, index 0 is unused (task handler thread)*/
+    uint32_t thread_cnt;          /*Rendering threads, the task handler thread included*/
+    bool stop;                    /*Set to make the workers exit*/
+} lv_refr_pool_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+static void lv_refr_merge_area(lv_disp_t * disp, const lv_area_t * area_p);
+static int32_t lv_refr_join_cost(const lv_area_t * a1_p, const lv_area_t * a2_p);
 static void lv_refr_areas(void);
 static void lv_refr_area(const lv_area_t * area_p);
+static lv_coord_t lv_refr_round_rows(lv_coord_t max_row);
 static void lv_refr_area_part(const lv_area_t * area_p);
+static void lv_refr_render(const lv_area_t * mask_p);
+#if LV_REFR_THREADS > 1
+static void lv_refr_render_parallel(const lv_area_t * mask_p);
+static uint32_t lv_refr_pool_start(void);
+static void lv_refr_pool_stop(void);
+static void * lv_refr_worker(void * arg);
+#endif
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
+static bool lv_refr_obj_covers(lv_obj_t * obj, const lv_area_t * area_p);
+static bool lv_refr_obj_opaque(lv_obj_t * obj, const lv_area_t * area_p);
+#if LV_REFR_CULL
+static bool lv_refr_cull(lv_ll_t * ll_p, lv_obj_t * first_p, const lv_area_t * clip_p, lv_area_t * mask_p);
+#endif
 static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p);
 static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p);
 static void lv_refr_vdb_flush(void);
+static void lv_refr_flush_part(const lv_area_t * area_p, lv_color_t * color_p, bool last);
+static bool lv_refr_buf_native(void);
+static bool lv_refr_diff_usable(const lv_area_t * area_p);
+static void lv_refr_diff_flush(lv_disp_buf_t * vdb);
+static void lv_refr_diff_band(lv_disp_buf_t * vdb, const lv_area_t * vdb_area_p, const lv_area_t * band_p,
+                              bool last);
+static void lv_refr_wait_flush(lv_disp_buf_t * vdb);
+static void lv_refr_wake(lv_disp_t * disp);
+static void lv_refr_frame_begin(void);
+static void lv_refr_frame_end(uint32_t time);
+#if LV_REFR_MOVE_CNT
+static void lv_refr_moves(void);
+static bool lv_refr_move_areas(const lv_disp_move_t * move, lv_area_t * src_p, lv_area_t * dest_p,
+                               lv_area_t * copy_p);
+static bool lv_refr_obj_on_top(lv_obj_t * obj, const lv_area_t * area_p);
+static bool lv_refr_list_on(lv_ll_t * ll_p, lv_obj_t * first_p, const lv_area_t * area_p);
+static void lv_refr_inv_diff(lv_disp_t * disp, const lv_area_t * a1, const lv_area_t * a2);
+static void lv_refr_diff_copy(const lv_area_t * dest_p, const lv_area_t * src_p);
+static void lv_refr_buf_copy(uint8_t * dest_buf, const uint8_t * src_buf, const lv_area_t * dest_p,
+                             const lv_area_t * src_p);
+#endif
+#if LV_LAYER_CACHE_SIZE
+static void lv_refr_layers(void);
+static void lv_refr_layer_render(lv_layer_cache_entry_t * entry);
+static bool lv_refr_layer_needed(lv_obj_t * obj);
+static bool lv_refr_layer_fits(lv_obj_t * obj);
+static bool lv_refr_layer_valid(const lv_layer_cache_entry_t * entry);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t px_num;
 static lv_disp_t * disp_refr; /*Display being refreshed*/
+static LV_REFR_TLS uint32_t draw_px; /*Pixels passed to the objects to draw, by this thread*/
+static LV_REFR_TLS uint32_t cull_px; /*Pixels not drawn because they are hidden, by this thread*/
+#if LV_LAYER_CACHE_SIZE
+static lv_obj_t * layer_p; /*Object being rendered into its layer*/
+#endif
+#if LV_REFR_THREADS > 1
+static lv_refr_pool_t pool = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .start = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+};
+static pthread_mutex_t draw_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
 
 /**********************
  *      MACROS
@@ -64,6 +148,19 @@ void lv_refr_init(void)
     /*Nothing to do*/
 }
 
+/**
+ * Deinitialize the screen refresh subsystem.
+ * Stop the rendering threads and free the draw buffers.
+ * Call it from the task handler thread when nothing is being refreshed.
+ */
+void lv_refr_deinit(void)
+{
+#if LV_REFR_THREADS > 1
+    lv_refr_pool_stop();
+#endif
+    lv_draw_free_buf();
+}
+
 /**
  * Redraw the invalidated areas now.
  * Normally the redrawing is periodically executed in `lv_task_handler` but a long blocking process
@@ -115,7 +212,7 @@ void lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
 
     /*The area is truncated to the screen*/
     if(suc != false) {
-        if(disp->driver.rounder_cb) disp->driver.rounder_cb(&disp_refr->driver, &com_area);
+        if(disp->driver.rounder_cb) disp->driver.rounder_cb(&disp->driver, &com_area);
 
         /*Save only if this area is not in one of the saved areas*/
         uint16_t i;
@@ -126,12 +223,143 @@ void lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
         /*Save the area*/
         if(disp->inv_p < LV_INV_BUF_SIZE) {
             lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
-        } else { /*If no place for the area add the screen*/
-            disp->inv_p = 0;
-            lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
+            disp->inv_p++;
+        } else { /*If no place for the area merge two areas instead of refreshing the screen*/
+            lv_refr_merge_area(disp, &com_area);
+            disp->inv_merge_cnt++;
+        }
+
+        lv_refr_wake(disp);
+    }
+}
+
+/**
+ * Copy the drawn pixels of an object to its new position in the next refresh instead of redrawing
+ * its old and new area. Needs the `copy_cb` of the display driver, with true double buffering the
+ * pixels are copied in the buffers.
+ * Call it before the coordinates of the object are changed.
+ * @param obj pointer to an object which is moved
+ * @param x_ofs horizontal movement
+ * @param y_ofs vertical movement
+ * @return true: the move is saved, `obj` needn't be invalidated; false: invalidate `obj` as usual
+ */
+bool lv_refr_move(lv_obj_t * obj, lv_coord_t x_ofs, lv_coord_t y_ofs)
+{
+#if LV_REFR_MOVE_CNT
+    /*The shadow etc. outside of the object can't be copied as it's not opaque*/
+    if(obj->ext_draw_pad != 0) return false;
+
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    if(disp == NULL) return false;
+    if(disp->driver.copy_cb == NULL && lv_disp_is_true_double_buf(disp) == false) return false;
+
+    /*Moving a hidden object doesn't change the display*/
+    const lv_obj_t * par;
+    for(par = obj; par != NULL; par = lv_obj_get_parent(par)) {
+        if(par->hidden != 0) return false;
+    }
+
+    /*Moved again since the last refresh?*/
+    lv_disp_move_t * move = NULL;
+    uint8_t i;
+    for(i = 0; i < disp->move_cnt; i++) {
+        if(disp->moves[i].obj == obj) move = &disp->moves[i];
+    }
+
+    if(move == NULL) {
+        if(disp->move_cnt >= LV_REFR_MOVE_CNT) return false;
+
+        move      = &disp->moves[disp->move_cnt];
+        move->obj = obj;
+        lv_area_copy(&move->src, &obj->coords);
+        lv_area_copy(&move->dest, &obj->coords);
+        disp->move_cnt++;
+    }
+
+    move->dest.x1 += x_ofs;
+    move->dest.y1 += y_ofs;
+    move->dest.x2 += x_ofs;
+    move->dest.y2 += y_ofs;
+
+    lv_refr_wake(disp);
+
+    return true;
+#else
+    (void)obj;   /*Unused*/
+    (void)x_ofs; /*Unused*/
+    (void)y_ofs; /*Unused*/
+    return false;
+#endif
+}
+
+/**
+ * Forget the saved moves of an object (e.g. because it's deleted) and invalidate its areas instead
+ * @param obj pointer to an object
+ */
+void lv_refr_move_cancel(const lv_obj_t * obj)
+{
+#if LV_REFR_MOVE_CNT
+    lv_disp_t * disp;
+    for(disp = lv_disp_get_next(NULL); disp != NULL; disp = lv_disp_get_next(disp)) {
+        uint8_t i;
+        for(i = 0; i < disp->move_cnt; i++) {
+            if(disp->moves[i].obj != obj) continue;
+
+            lv_inv_area(disp, &disp->moves[i].src);
+            lv_inv_area(disp, &disp->moves[i].dest);
+
+            /*Keep the moves packed*/
+            disp->move_cnt--;
+            disp->moves[i] = disp->moves[disp->move_cnt];
+            break;
         }
-        disp->inv_p++;
     }
+#else
+    (void)obj; /*Unused*/
+#endif
+}
+
+/**
+ * Render the layers of the cached objects on a screen which aren't valid, e.g. before the screen is
+ * loaded. Normally a layer is rendered when its object is drawn and wasn't changed since the last refresh.
+ * Call it from the task handler thread.
+ * @param scr pointer to a screen
+ */
+void lv_refr_render_layers(lv_obj_t * scr)
+{
+#if LV_LAYER_CACHE_SIZE
+    lv_disp_t * disp = lv_obj_get_disp(scr);
+    if(disp == NULL) return;
+
+    lv_disp_t * disp_prev = disp_refr;
+    disp_refr             = disp;
+
+    if(lv_refr_buf_native()) {
+        /*The driver may use the area of the VDB until the flush is ready*/
+        lv_refr_wait_flush(lv_disp_get_buf(disp));
+
+        lv_layer_cache_entry_t * entry = lv_layer_cache_get_next(NULL);
+        while(entry != NULL) {
+            lv_obj_t * obj = entry->obj;
+            bool hidden    = false;
+            const lv_obj_t * par;
+            for(par = obj; par != NULL; par = lv_obj_get_parent(par)) {
+                if(par->hidden != 0) hidden = true;
+            }
+
+            if(hidden == false && lv_obj_get_screen(obj) == scr && lv_refr_layer_valid(entry) == false &&
+               lv_refr_layer_fits(obj)) {
+                lv_refr_layer_render(entry);
+                entry->changed = 0;
+            }
+            entry = lv_layer_cache_get_next(entry);
+        }
+    }
+
+    disp_refr = disp_prev;
+#else
+    (void)scr; /*Unused*/
+#endif
 }
 
 /**
@@ -154,6 +382,28 @@ void lv_refr_set_disp_refreshing(lv_disp_t * disp)
     disp_refr = disp;
 }
 
+/**
+ * Serialize drawing code which is not reentrant, e.g. code which temporally
+ * modifies an object or uses a shared cache.
+ * Does nothing if `LV_REFR_THREADS <= 1`. Must not be nested.
+ */
+void lv_refr_lock(void)
+{
+#if LV_REFR_THREADS > 1
+    pthread_mutex_lock(&draw_mutex);
+#endif
+}
+
+/**
+ * Release the lock taken with `lv_refr_lock`
+ */
+void lv_refr_unlock(void)
+{
+#if LV_REFR_THREADS > 1
+    pthread_mutex_unlock(&draw_mutex);
+#endif
+}
+
 /**
  * Called periodically to handle the refreshing
  * @param task pointer to the task itself
@@ -162,29 +412,63 @@ void lv_disp_refr_task(lv_task_t * task)
 {
     LV_LOG_TRACE("lv_refr_task: started");
 
+    disp_refr = task->user_data;
+
+    /*Don't wait for the vertical sync if there is nothing to refresh*/
+    bool refr = disp_refr->inv_p != 0;
+#if LV_REFR_MOVE_CNT
+    refr = refr || disp_refr->move_cnt != 0;
+#endif
+    if(refr) lv_refr_frame_begin();
+
     uint32_t start = lv_tick_get();
 
-    disp_refr = task->user_data;
+    /*The last flushed frame is unknown (e.g. the driver is updated): refresh the whole screen to
+     * save it*/
+    if(refr && disp_refr->driver.diff_buf && disp_refr->diff_valid == 0) {
+        lv_area_t scr_area;
+        scr_area.x1 = 0;
+        scr_area.y1 = 0;
+        scr_area.x2 = lv_disp_get_hor_res(disp_refr) - 1;
+        scr_area.y2 = lv_disp_get_ver_res(disp_refr) - 1;
+        lv_inv_area(disp_refr, &scr_area);
+    }
+
+#if LV_REFR_MOVE_CNT
+    lv_refr_moves();
+#endif
 
     lv_refr_join_area();
 
+#if LV_LAYER_CACHE_SIZE
+    lv_refr_layers();
+#endif
+
     lv_refr_areas();
 
+    /*The last flushed frame was saved while the whole screen was refreshed*/
+    if(refr && disp_refr->driver.diff_buf) disp_refr->diff_valid = 1;
+
     /*If refresh happened ...*/
+#if LV_REFR_MOVE_CNT
+    if(disp_refr->inv_p != 0 || disp_refr->copied_cnt != 0) {
+#else
     if(disp_refr->inv_p != 0) {
+#endif
         /*In true double buffered mode copy the refreshed areas to the new VDB to keep it up to
          * date*/
         if(lv_disp_is_true_double_buf(disp_refr)) {
             lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
 
             /*Flush the content of the VDB*/
+            vdb->last_area = 1;
+            vdb->last_part = 1;
             lv_refr_vdb_flush();
 
             /* With true double buffering the flushing should be only the address change of the
              * current frame buffer. Wait until the address change is ready and copy the changed
              * content to the other frame buffer (new active VDB) to keep the buffers synchronized*/
-            while(vdb->flushing)
-                ;
+            lv_refr_wait_flush(vdb);
 
             uint8_t * buf_act = (uint8_t *)vdb->buf_act;
             uint8_t * buf_ina = (uint8_t *)vdb->buf_act == vdb->buf1 ? vdb->buf2 : vdb->buf1;
@@ -204,6 +488,14 @@ void lv_disp_refr_task(lv_task_t * task)
                     }
                 }
             }
+
+#if LV_REFR_MOVE_CNT
+            /*The moved objects were copied only in the flushed buffer, copy them here too*/
+            for(a = 0; a < disp_refr->copied_cnt; a++) {
+                lv_refr_buf_copy(buf_act, buf_ina, &disp_refr->copied[a], &disp_refr->copied[a]);
+            }
+            disp_refr->copied_cnt = 0;
+#endif
         } /*End of true double buffer handling*/
 
         /*Clean up*/
@@ -211,14 +503,22 @@ void lv_disp_refr_task(lv_task_t * task)
         memset(disp_refr->inv_area_joined, 0, sizeof(disp_refr->inv_area_joined));
         disp_refr->inv_p = 0;
 
+        uint32_t time = lv_tick_elaps(start);
+
         /*Call monitor cb if present*/
         if(disp_refr->driver.monitor_cb) {
-            disp_refr->driver.monitor_cb(&disp_refr->driver, lv_tick_elaps(start), px_num);
+            disp_refr->driver.monitor_cb(&disp_refr->driver, time, px_num);
         }
+
+        lv_refr_frame_end(time);
     }
 
     lv_draw_free_buf();
 
+    /*Everything is refreshed: don't wake up until a new area is invalidated (see `lv_inv_area`)*/
+    if(disp_refr->refr_task) lv_task_set_prio(disp_refr->refr_task, LV_TASK_PRIO_OFF);
+    disp_refr->inv_timed = 0;
+
     LV_LOG_TRACE("lv_refr_task: ready");
 }
 
@@ -227,40 +527,152 @@ void lv_disp_refr_task(lv_task_t * task)
  **********************/
 
 /**
- * Join the areas which has got common parts
+ * Turn on the refresh task if it was turned off because there was nothing to refresh
+ * @param disp pointer to a display with a new invalid area
+ */
+static void lv_refr_wake(lv_disp_t * disp)
+{
+    if(disp->refr_task && disp->refr_task->prio == LV_TASK_PRIO_OFF) {
+        lv_task_set_prio(disp->refr_task, LV_TASK_PRIO_MID);
+
+        /*The next frame is due in a period*/
+        disp->inv_time  = lv_tick_get();
+        disp->inv_timed = 1;
+    }
+}
+
+/**
+ * Wait for the vertical sync before a frame if the driver supports it,
+ * and count the late and dropped frames
+ */
+static void lv_refr_frame_begin(void)
+{
+    lv_disp_drv_t * drv = &disp_refr->driver;
+    if(drv->vsync_cb && disp_refr->vsync_off == 0 && drv->vsync_cb(drv) == false) disp_refr->vsync_off = 1;
+
+    if(disp_refr->inv_timed == 0) return;
+
+    uint32_t budget  = (uint32_t)drv->refr_period * disp_refr->refr_div;
+    uint32_t latency = lv_tick_elaps(disp_refr->inv_time);
+    if(budget != 0 && latency > budget) {
+        disp_refr->frame_late_cnt++;
+        disp_refr->frame_drop_cnt += latency / budget - 1;
+    }
+}
+
+/**
+ * Adapt the refresh period to the render time: refresh in every 2nd, 3rd... period while the frames
+ * overrun to keep a steady frame rate, and go back when they are fast again
+ * @param time render time of the frame [ms]
+ */
+static void lv_refr_frame_end(uint32_t time)
+{
+    uint32_t period = disp_refr->driver.refr_period;
+    uint8_t div     = disp_refr->refr_div;
+    if(period == 0 || disp_refr->refr_task == NULL) return;
+
+    if(time > period * div) {
+        div = time / period + 1;
+        if(div > LV_REFR_DIV_MAX) div = LV_REFR_DIV_MAX;
+    } else if(div > 1 && time < period * (div - 1) / 2) {
+        div--;
+    }
+
+    if(div != disp_refr->refr_div) {
+        disp_refr->refr_div = div;
+        lv_task_set_period(disp_refr->refr_task, period * div);
+    }
+}
+
+/**
+ * Join the areas whose bounding box costs less to refresh than the areas one by one
  */
 static void lv_refr_join_area(void)
 {
     uint32_t join_from;
     uint32_t join_in;
     lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
-
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
-            }
-
-            /*Check if the areas are on each other*/
-            if(lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
-            }
+    bool joined;
+
+    /*A joined area is larger, it may be worth joining with areas already checked. Repeat until
+     * nothing is joined*/
+    do {
+        joined = false;
+        for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
+            if(disp_refr->inv_area_joined[join_in] != 0) continue;
+
+            /*Check all areas to join them in 'join_in'*/
+            for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
+                /*Handle only unjoined areas and ignore itself*/
+                if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
+                    continue;
+                }
 
-            lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+                /*Join two areas only if it doesn't add more pixels than flushing one more area costs*/
+                if(lv_refr_join_cost(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) >
+                   (int32_t)disp_refr->driver.area_cost) {
+                    continue;
+                }
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
+                lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
                 lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
 
                 /*Mark 'join_form' is joined into 'join_in'*/
                 disp_refr->inv_area_joined[join_from] = 1;
+                joined                                = true;
+            }
+        }
+    } while(joined);
+}
+
+/**
+ * Make room for an area in the full invalidate buffer of a display. The two areas, the new one
+ * included, whose bounding box adds the fewest pixels are replaced by their bounding box.
+ * @param disp pointer to a display with a full invalidate buffer
+ * @param area_p pointer to the area to save
+ */
+static void lv_refr_merge_area(lv_disp_t * disp, const lv_area_t * area_p)
+{
+    uint32_t area_cnt = disp->inv_p;
+    uint32_t best_a   = area_cnt; /*'area_cnt' is the new area*/
+    uint32_t best_b   = 0;
+    int32_t best_cost = INT32_MAX;
+    uint32_t a;
+    uint32_t b;
+
+    for(a = 0; a <= area_cnt; a++) {
+        const lv_area_t * a_p = a < area_cnt ? &disp->inv_areas[a] : area_p;
+        for(b = 0; b < a && b < area_cnt; b++) {
+            int32_t cost = lv_refr_join_cost(a_p, &disp->inv_areas[b]);
+            if(cost < best_cost) {
+                best_cost = cost;
+                best_a    = a;
+                best_b    = b;
             }
         }
     }
+
+    lv_area_t joined_area;
+    lv_area_join(&joined_area, best_a < area_cnt ? &disp->inv_areas[best_a] : area_p, &disp->inv_areas[best_b]);
+    lv_area_copy(&disp->inv_areas[best_b], &joined_area);
+
+    /*Two saved areas were merged, save the new area in the freed place*/
+    if(best_a < area_cnt) lv_area_copy(&disp->inv_areas[best_a], area_p);
+}
+
+/**
+ * Get how many more pixels the bounding box of two areas has than the two areas together
+ * @param a1_p pointer to an area
+ * @param a2_p pointer to an other area
+ * @return the extra pixels, negative if the areas overlap and their bounding box is smaller
+ */
+static int32_t lv_refr_join_cost(const lv_area_t * a1_p, const lv_area_t * a2_p)
+{
+    lv_area_t joined_area;
+    lv_area_join(&joined_area, a1_p, a2_p);
+
+    return (int32_t)lv_area_get_size(&joined_area) - (int32_t)lv_area_get_size(a1_p) -
+           (int32_t)lv_area_get_size(a2_p);
 }
 
 /**
@@ -268,12 +680,22 @@ static void lv_refr_join_area(void)
  */
 static void lv_refr_areas(void)
 {
-    px_num = 0;
+    px_num                  = 0;
+    disp_refr->draw_px      = 0;
+    disp_refr->cull_px      = 0;
     uint32_t i;
 
+    /*Find the last area to tell the driver which flush ends the frame*/
+    uint32_t last_i = 0;
+    for(i = 0; i < disp_refr->inv_p; i++) {
+        if(disp_refr->inv_area_joined[i] == 0) last_i = i;
+    }
+
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
     for(i = 0; i < disp_refr->inv_p; i++) {
         /*Refresh the unjoined areas*/
         if(disp_refr->inv_area_joined[i] == 0) {
+            vdb->last_area = i == last_i ? 1 : 0;
 
             lv_refr_area(&disp_refr->inv_areas[i]);
 
@@ -313,29 +735,11 @@ static void lv_refr_area(const lv_area_t * area_p)
 
         /*Round down the lines of VDB if rounding is added*/
         if(disp_refr->driver.rounder_cb) {
-            lv_area_t tmp;
-            tmp.x1 = 0;
-            tmp.x2 = 0;
-            tmp.y1 = 0;
-
-            lv_coord_t y_tmp = max_row - 1;
-            do {
-                tmp.y2 = y_tmp;
-                disp_refr->driver.rounder_cb(&disp_refr->driver, &tmp);
-
-                /*If this height fits into `max_row` then fine*/
-                if(lv_area_get_height(&tmp) <= max_row) break;
-
-                /*Decrement the height of the area until it fits into `max_row` after rounding*/
-                y_tmp--;
-            } while(y_tmp != 0);
-
-            if(y_tmp == 0) {
+            max_row = lv_refr_round_rows(max_row);
+            if(max_row == 0) {
                 LV_LOG_WARN("Can't set VDB height using the round function. (Wrong round_cb or to "
                             "small VDB)");
                 return;
-            } else {
-                max_row = tmp.y2 + 1;
             }
         }
 
@@ -350,6 +754,7 @@ static void lv_refr_area(const lv_area_t * area_p)
             vdb->area.y2 = row + max_row - 1;
             if(vdb->area.y2 > y2) vdb->area.y2 = y2;
             row_last = vdb->area.y2;
+            vdb->last_part = row_last == y2 ? 1 : 0;
             lv_refr_area_part(area_p);
         }
 
@@ -360,6 +765,7 @@ static void lv_refr_area(const lv_area_t * area_p)
             vdb->area.x2 = area_p->x2;
             vdb->area.y1 = row;
             vdb->area.y2 = y2;
+            vdb->last_part = 1;
 
             /*Refresh this part too*/
             lv_refr_area_part(area_p);
@@ -367,6 +773,39 @@ static void lv_refr_area(const lv_area_t * area_p)
     }
 }
 
+/**
+ * Get how many rows of the VDB can be used if the driver rounds the areas.
+ * The rounded height grows with the height, so the tallest area which still fits is searched
+ * by halving the range instead of trying every height from `max_row` down.
+ * @param max_row number of rows fitting into the VDB
+ * @return the number of rows to render at once, 0 if even one row doesn't fit after rounding
+ */
+static lv_coord_t lv_refr_round_rows(lv_coord_t max_row)
+{
+    lv_coord_t lo = 0;
+    lv_coord_t hi = max_row - 1;
+    lv_coord_t rows = 0;
+    lv_area_t tmp;
+
+    while(lo <= hi) {
+        lv_coord_t mid = lo + (hi - lo) / 2;
+        tmp.x1 = 0;
+        tmp.x2 = 0;
+        tmp.y1 = 0;
+        tmp.y2 = mid;
+        disp_refr->driver.rounder_cb(&disp_refr->driver, &tmp);
+
+        if(lv_area_get_height(&tmp) <= max_row) {
+            rows = tmp.y2 + 1;
+            lo   = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    return rows;
+}
+
 /**
  * Refresh a part of an area which is on the actual Virtual Display Buffer
  * @param area_p pointer to an area to refresh
@@ -379,34 +818,190 @@ static void lv_refr_area_part(const lv_area_t * area_p)
     /*In non double buffered mode, before rendering the next part wait until the previous image is
      * flushed*/
     if(lv_disp_is_double_buf(disp_refr) == false) {
-        while(vdb->flushing)
-            ;
+        lv_refr_wait_flush(vdb);
     }
 
-    lv_obj_t * top_p;
-
     /*Get the new mask from the original area and the act. VDB
      It will be a part of 'area_p'*/
     lv_area_t start_mask;
     lv_area_intersect(&start_mask, area_p, &vdb->area);
 
+#if LV_REFR_THREADS > 1
+    lv_refr_render_parallel(&start_mask);
+#else
+    lv_refr_render(&start_mask);
+#endif
+
+    /* In true double buffered mode flush only once when all areas were rendered.
+     * In normal mode flush after every area */
+    if(lv_disp_is_true_double_buf(disp_refr) == false) {
+        lv_refr_vdb_flush();
+    }
+}
+
+/**
+ * Render the objects on an area into the VDB
+ * @param mask_p the area to render, must be on the VDB
+ */
+static void lv_refr_render(const lv_area_t * mask_p)
+{
+    draw_px = 0;
+    cull_px = 0;
+
     /*Get the most top object which is not covered by others*/
-    top_p = lv_refr_get_top_obj(&start_mask, lv_disp_get_scr_act(disp_refr));
+    lv_obj_t * top_p = lv_refr_get_top_obj(mask_p, lv_disp_get_scr_act(disp_refr));
 
     /*Do the refreshing from the top object*/
-    lv_refr_obj_and_children(top_p, &start_mask);
+    lv_refr_obj_and_children(top_p, mask_p);
 
     /*Also refresh top and sys layer unconditionally*/
-    lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), &start_mask);
-    lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), &start_mask);
+    lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), mask_p);
+    lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), mask_p);
+
+    /*Add the counters of this thread to the display's*/
+    lv_refr_lock();
+    disp_refr->draw_px += draw_px;
+    disp_refr->cull_px += cull_px;
+    lv_refr_unlock();
+}
 
-    /* In true double buffered mode flush only once when all areas were rendered.
-     * In normal mode flush after every area */
-    if(lv_disp_is_true_double_buf(disp_refr) == false) {
-        lv_refr_vdb_flush();
+#if LV_REFR_THREADS > 1
+/**
+ * Render an area in horizontal bands, one band per thread.
+ * The bands are disjoint parts of the VDB so the threads don't write the same pixels.
+ * @param mask_p the area to render, must be on the VDB
+ */
+static void lv_refr_render_parallel(const lv_area_t * mask_p)
+{
+    uint32_t thread_cnt = lv_refr_pool_start();
+    lv_coord_t h = lv_area_get_height(mask_p);
+    uint32_t band_cnt = h / LV_REFR_MIN_BAND_ROWS;
+    if(band_cnt > thread_cnt) band_cnt = thread_cnt;
+
+    /*Not worth to wake up the workers for a small area*/
+    if(band_cnt < 2) {
+        lv_refr_render(mask_p);
+        return;
     }
+
+    lv_coord_t band_h = (h + band_cnt - 1) / band_cnt;
+    lv_area_t band0;
+
+    pthread_mutex_lock(&pool.mutex);
+    uint32_t i;
+    for(i = 0; i < band_cnt; i++) {
+        lv_area_t * band = &pool.bands[i];
+        lv_area_copy(band, mask_p);
+        band->y1 = mask_p->y1 + i * band_h;
+        band->y2 = band->y1 + band_h - 1;
+        if(band->y2 > mask_p->y2) band->y2 = mask_p->y2;
+    }
+    lv_area_copy(&band0, &pool.bands[0]);
+    pool.band_cnt = band_cnt;
+    pool.pending  = band_cnt - 1;
+    pool.gen++;
+    pthread_cond_broadcast(&pool.start);
+    pthread_mutex_unlock(&pool.mutex);
+
+    /*The first band is rendered by this thread*/
+    lv_refr_render(&band0);
+
+    pthread_mutex_lock(&pool.mutex);
+    while(pool.pending > 0) {
+        pthread_cond_wait(&pool.done, &pool.mutex);
+    }
+    pthread_mutex_unlock(&pool.mutex);
 }
 
+/**
+ * Start the worker threads if not started yet.
+ * No more threads than CPUs are used.
+ * @return number of rendering threads, the task handler thread included
+ */
+static uint32_t lv_refr_pool_start(void)
+{
+    if(pool.thread_cnt > 0) return pool.thread_cnt;
+
+    long cpu_cnt = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t thread_cnt = LV_REFR_THREADS;
+    if(cpu_cnt > 0 && (uint32_t)cpu_cnt < thread_cnt) thread_cnt = cpu_cnt;
+
+    uintptr_t i;
+    for(i = 1; i < thread_cnt; i++) {
+        /*The workers inherit the scheduling of the task handler thread*/
+        if(pthread_create(&pool.threads[i], NULL, lv_refr_worker, (void *)i) != 0) {
+            LV_LOG_WARN("lv_refr_pool_start: can't create rendering thread");
+            break;
+        }
+    }
+
+    /*Use the workers created so far*/
+    pool.thread_cnt = i;
+    return pool.thread_cnt;
+}
+
+/**
+ * Make the worker threads exit and wait for them.
+ * The pool is started again when an area is rendered.
+ */
+static void lv_refr_pool_stop(void)
+{
+    if(pool.thread_cnt == 0) return;
+
+    pthread_mutex_lock(&pool.mutex);
+    pool.stop = true;
+    pthread_cond_broadcast(&pool.start);
+    pthread_mutex_unlock(&pool.mutex);
+
+    uint32_t i;
+    for(i = 1; i < pool.thread_cnt; i++) {
+        pthread_join(pool.threads[i], NULL);
+    }
+
+    /*New workers start from the first generation*/
+    pool.stop       = false;
+    pool.gen        = 0;
+    pool.thread_cnt = 0;
+}
+
+/**
+ * Rendering thread, renders the band with the same index as the thread
+ * @param arg index of the thread, 1..LV_REFR_THREADS-1
+ */
+static void * lv_refr_worker(void * arg)
+{
+    uint32_t id = (uint32_t)(uintptr_t)arg;
+    uint32_t gen = 0;
+
+    pthread_mutex_lock(&pool.mutex);
+    while(1) {
+        while(pool.gen == gen && pool.stop == false) {
+            pthread_cond_wait(&pool.start, &pool.mutex);
+        }
+        if(pool.stop) break;
+
+        gen = pool.gen;
+        if(id >= pool.band_cnt) continue;
+
+        lv_area_t band;
+        lv_area_copy(&band, &pool.bands[id]);
+        pthread_mutex_unlock(&pool.mutex);
+
+        lv_refr_render(&band);
+
+        pthread_mutex_lock(&pool.mutex);
+        pool.pending--;
+        if(pool.pending == 0) pthread_cond_signal(&pool.done);
+    }
+    pthread_mutex_unlock(&pool.mutex);
+
+    /*Free the draw buffer of this thread*/
+    lv_draw_free_buf();
+
+    return NULL;
+}
+#endif
+
 /**
  * Search the most top object which fully covers an area
  * @param area_p pointer to an area
@@ -431,18 +1026,101 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
         }
 
         /*If no better children check this object*/
-        if(found_p == NULL) {
-            const lv_style_t * style = lv_obj_get_style(obj);
-            if(style->body.opa == LV_OPA_COVER && obj->design_cb(obj, area_p, LV_DESIGN_COVER_CHK) != false &&
-               lv_obj_get_opa_scale(obj) == LV_OPA_COVER) {
-                found_p = obj;
-            }
+        if(found_p == NULL && lv_refr_obj_covers(obj, area_p)) {
+            found_p = obj;
         }
     }
 
     return found_p;
 }
 
+/**
+ * Check if an object is drawn opaque on the whole of an area
+ * @param obj pointer to an object
+ * @param area_p pointer to an area
+ * @return true: nothing under `obj` is visible on `area_p`
+ */
+static bool lv_refr_obj_covers(lv_obj_t * obj, const lv_area_t * area_p)
+{
+    if(lv_refr_obj_opaque(obj, area_p)) return true;
+
+#if LV_LAYER_CACHE_SIZE
+    /*A layer is opaque as it holds the parent behind the object too*/
+    if(obj->layer_cache && obj->hidden == 0 && lv_area_is_in(area_p, &obj->coords)) {
+        lv_layer_cache_entry_t * entry = lv_layer_cache_find(obj);
+        return entry != NULL && lv_refr_layer_valid(entry);
+    }
+#endif
+
+    return false;
+}
+
+/**
+ * Check if an object draws itself opaque on the whole of an area
+ * @param obj pointer to an object
+ * @param area_p pointer to an area
+ * @return true: the drawing of `obj` hides everything under it on `area_p`
+ */
+static bool lv_refr_obj_opaque(lv_obj_t * obj, const lv_area_t * area_p)
+{
+    if(obj->hidden != 0 || lv_area_is_in(area_p, &obj->coords) == false) return false;
+
+    const lv_style_t * style = lv_obj_get_style(obj);
+    return style->body.opa == LV_OPA_COVER && obj->design_cb(obj, area_p, LV_DESIGN_COVER_CHK) != false &&
+           lv_obj_get_opa_scale(obj) == LV_OPA_COVER;
+}
+
+#if LV_REFR_CULL
+/**
+ * Remove the parts of a mask which are hidden by opaque objects drawn on top of it.
+ * The mask remains a rectangle, so an object is taken into account only if it covers a whole edge.
+ * @param ll_p pointer to the list of the objects drawn on top (children of an object)
+ * @param first_p the oldest object in `ll_p` to check, the younger ones are checked too
+ * @param clip_p pointer to the area the objects in `ll_p` are drawn in (their parent)
+ * @param mask_p pointer to the area to draw. Reduced to the not hidden part.
+ * @return false: the whole mask is hidden, don't draw anything
+ */
+static bool lv_refr_cull(lv_ll_t * ll_p, lv_obj_t * first_p, const lv_area_t * clip_p, lv_area_t * mask_p)
+{
+    lv_obj_t * i = first_p;
+    while(i != NULL) {
+        lv_area_t cover;
+        if(i->hidden == 0 && lv_area_intersect(&cover, mask_p, &i->coords) &&
+           lv_area_intersect(&cover, &cover, clip_p)) {
+            bool full_w = cover.x1 == mask_p->x1 && cover.x2 == mask_p->x2;
+            bool full_h = cover.y1 == mask_p->y1 && cover.y2 == mask_p->y2;
+            bool edge_y = full_w && (cover.y1 == mask_p->y1 || cover.y2 == mask_p->y2);
+            bool edge_x = full_h && (cover.x1 == mask_p->x1 || cover.x2 == mask_p->x2);
+
+            if((edge_y || edge_x) && lv_refr_obj_covers(i, &cover)) {
+                uint32_t size = lv_area_get_size(mask_p);
+                if(full_w && full_h) {
+                    cull_px += size;
+                    return false;
+                }
+
+                if(edge_y) {
+                    if(cover.y1 == mask_p->y1)
+                        mask_p->y1 = cover.y2 + 1;
+                    else
+                        mask_p->y2 = cover.y1 - 1;
+                } else {
+                    if(cover.x1 == mask_p->x1)
+                        mask_p->x1 = cover.x2 + 1;
+                    else
+                        mask_p->x2 = cover.x1 - 1;
+                }
+                cull_px += size - lv_area_get_size(mask_p);
+            }
+        }
+        /*The younger objects are drawn later*/
+        i = lv_ll_get_prev(ll_p, i);
+    }
+
+    return true;
+}
+#endif
+
 /**
  * Make the refreshing from an object. Draw all its children and the youngers too.
  * @param top_p pointer to an objects. Start the drawing from it.
@@ -510,11 +1188,44 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
     obj_area.y2 += ext_size;
     union_ok = lv_area_intersect(&obj_ext_mask, mask_ori_p, &obj_area);
 
+#if LV_REFR_CULL
+    /*Don't draw what the younger siblings will cover*/
+    lv_obj_t * par = lv_obj_get_parent(obj);
+#if LV_LAYER_CACHE_SIZE
+    if(obj == layer_p) par = NULL; /*The siblings are not in the layer*/
+#endif
+    if(union_ok != false && par != NULL) {
+        union_ok = lv_refr_cull(&par->child_ll, lv_ll_get_prev(&par->child_ll, obj), &par->coords, &obj_ext_mask);
+    }
+#endif
+
+#if LV_LAYER_CACHE_SIZE
+    /*Draw the cached layer instead of the object and its children*/
+    if(union_ok != false && obj->layer_cache && obj != layer_p) {
+        lv_layer_cache_entry_t * entry = lv_layer_cache_find(obj);
+        if(entry != NULL && lv_refr_layer_valid(entry)) {
+            draw_px += lv_area_get_size(&obj_ext_mask);
+            lv_draw_map(&entry->area, &obj_ext_mask, (const uint8_t *)entry->buf, LV_OPA_COVER, false, false,
+                        LV_COLOR_BLACK, LV_OPA_TRANSP);
+            return;
+        }
+    }
+#endif
+
     /*Draw the parent and its children only if they ore on 'mask_parent'*/
     if(union_ok != false) {
 
-        /* Redraw the object */
-        obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_MAIN);
+        /* Redraw the object, except where its children will cover it*/
+        lv_area_t main_mask;
+        bool main_ok = true;
+        lv_area_copy(&main_mask, &obj_ext_mask);
+#if LV_REFR_CULL
+        main_ok = lv_refr_cull(&obj->child_ll, lv_ll_get_tail(&obj->child_ll), &obj->coords, &main_mask);
+#endif
+        if(main_ok) {
+            draw_px += lv_area_get_size(&main_mask);
+            obj->design_cb(obj, &main_mask, LV_DESIGN_DRAW_MAIN);
+        }
 
 #if MASK_AREA_DEBUG
         static lv_color_t debug_color = LV_COLOR_RED;
@@ -524,7 +1235,7 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
 #endif
         /*Create a new 'obj_mask' without 'ext_size' because the children can't be visible there*/
         lv_obj_get_coords(obj, &obj_area);
-        union_ok = lv_area_intersect(&obj_mask, mask_ori_p, &obj_area);
+        union_ok = lv_area_intersect(&obj_mask, &obj_ext_mask, &obj_area);
         if(union_ok != false) {
             lv_area_t mask_child; /*Mask from obj and its child*/
             lv_obj_t * child_p;
@@ -564,15 +1275,15 @@ static void lv_refr_vdb_flush(void)
     /*In double buffered mode wait until the other buffer is flushed before flushing the current
      * one*/
     if(lv_disp_is_double_buf(disp_refr)) {
-        while(vdb->flushing)
-            ;
+        lv_refr_wait_flush(vdb);
     }
 
-    vdb->flushing = 1;
-
     /*Flush the rendered content to the display*/
-    lv_disp_t * disp = lv_refr_get_disp_refreshing();
-    if(disp->driver.flush_cb) disp->driver.flush_cb(&disp->driver, &vdb->area, vdb->buf_act);
+    if(lv_refr_diff_usable(&vdb->area)) {
+        lv_refr_diff_flush(vdb);
+    } else {
+        lv_refr_flush_part(&vdb->area, vdb->buf_act, vdb->last_area && vdb->last_part);
+    }
 
     if(vdb->buf1 && vdb->buf2) {
         if(vdb->buf_act == vdb->buf1)
@@ -581,3 +1292,568 @@ static void lv_refr_vdb_flush(void)
             vdb->buf_act = vdb->buf1;
     }
 }
+
+/**
+ * Pass a rendered area to the display driver
+ * @param area_p pointer to the area to flush
+ * @param color_p the pixels of the area
+ * @param last true: it's the last flush of the frame
+ */
+static void lv_refr_flush_part(const lv_area_t * area_p, lv_color_t * color_p, bool last)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
+
+    __atomic_store_n(&vdb->flushing, 1, __ATOMIC_RELAXED);
+    vdb->flushing_last = last ? 1 : 0;
+
+    if(disp_refr->driver.flush_cb) disp_refr->driver.flush_cb(&disp_refr->driver, area_p, color_p);
+}
+
+/**
+ * Tell if the VDB holds `lv_color_t` pixels
+ * @return false: the driver writes the VDB in its own format (`set_px_cb` or the span callbacks)
+ */
+static bool lv_refr_buf_native(void)
+{
+    return disp_refr->driver.set_px_cb == NULL && disp_refr->driver.fill_span_cb == NULL &&
+           disp_refr->driver.blend_span_cb == NULL;
+}
+
+/**
+ * Tell if a rendered area can be compared to the last flushed frame
+ * @param area_p pointer to the rendered area of the VDB
+ * @return true: the driver has a `diff_buf` and the area is on it
+ */
+static bool lv_refr_diff_usable(const lv_area_t * area_p)
+{
+    /*With true double buffering the buffers are the frames*/
+    if(disp_refr->driver.diff_buf == NULL) return false;
+    if(lv_refr_buf_native() == false) return false;
+    if(lv_disp_is_true_double_buf(disp_refr)) return false;
+
+    lv_area_t scr_area;
+    scr_area.x1 = 0;
+    scr_area.y1 = 0;
+    scr_area.x2 = lv_disp_get_hor_res(disp_refr) - 1;
+    scr_area.y2 = lv_disp_get_ver_res(disp_refr) - 1;
+
+    return lv_area_is_in(area_p, &scr_area);
+}
+
+/**
+ * Flush only the rows of the VDB which differ from the last flushed frame (`diff_buf` of the
+ * driver), cut to the columns which changed, and save them as the last frame.
+ * Unchanged rows between changed ones are flushed too if it costs less than one more flush.
+ * @param vdb pointer to the display buffer to flush
+ */
+static void lv_refr_diff_flush(lv_disp_buf_t * vdb)
+{
+    lv_area_t vdb_area;
+    lv_area_copy(&vdb_area, &vdb->area);
+
+    lv_color_t * buf      = vdb->buf_act;
+    lv_color_t * diff_buf = disp_refr->driver.diff_buf;
+    lv_coord_t hres       = lv_disp_get_hor_res(disp_refr);
+    lv_coord_t w          = lv_area_get_width(&vdb_area);
+    bool last             = vdb->last_area && vdb->last_part;
+    lv_coord_t y;
+
+    /*The last frame is not known yet, flush everything and save it*/
+    if(disp_refr->diff_valid == 0) {
+        for(y = vdb_area.y1; y <= vdb_area.y2; y++) {
+            memcpy(&diff_buf[y * hres + vdb_area.x1], &buf[(y - vdb_area.y1) * w], w * sizeof(lv_color_t));
+        }
+        lv_refr_flush_part(&vdb->area, buf, last);
+        return;
+    }
+
+    lv_area_t band;
+    bool band_open = false;
+    for(y = vdb_area.y1; y <= vdb_area.y2; y++) {
+        lv_color_t * row  = &buf[(y - vdb_area.y1) * w];
+        lv_color_t * prev = &diff_buf[y * hres + vdb_area.x1];
+
+        /*Most rows are the same, `memcmp` of the C library compares them fast*/
+        if(memcmp(row, prev, w * sizeof(lv_color_t)) == 0) continue;
+
+        lv_coord_t x1 = 0;
+        lv_coord_t x2 = w - 1;
+        while(row[x1].full == prev[x1].full) x1++;
+        while(row[x2].full == prev[x2].full) x2--;
+        memcpy(&prev[x1], &row[x1], (x2 - x1 + 1) * sizeof(lv_color_t));
+
+        x1 += vdb_area.x1;
+        x2 += vdb_area.x1;
+
+        if(band_open &&
+           (uint32_t)(y - band.y2 - 1) * lv_area_get_width(&band) <= disp_refr->driver.area_cost) {
+            if(x1 < band.x1) band.x1 = x1;
+            if(x2 > band.x2) band.x2 = x2;
+            band.y2 = y;
+        } else {
+            if(band_open) lv_refr_diff_band(vdb, &vdb_area, &band, false);
+
+            band.x1   = x1;
+            band.y1   = y;
+            band.x2   = x2;
+            band.y2   = y;
+            band_open = true;
+        }
+    }
+
+    if(band_open) {
+        lv_refr_diff_band(vdb, &vdb_area, &band, last);
+    }
+    /*Nothing changed but a driver collecting the areas has to know that the frame is ended*/
+    else if(last) {
+        band.x1 = vdb_area.x1;
+        band.y1 = vdb_area.y1;
+        band.x2 = vdb_area.x1;
+        band.y2 = vdb_area.y1;
+        lv_refr_diff_band(vdb, &vdb_area, &band, true);
+    }
+}
+
+/**
+ * Flush a part of the VDB. Its rows are moved to the beginning of the VDB first as the driver
+ * expects them continuously.
+ * @param vdb pointer to the display buffer to flush
+ * @param vdb_area_p the area rendered into the VDB
+ * @param band_p pointer to the part of `vdb_area_p` to flush
+ * @param last true: it's the last flush of the frame
+ */
+static void lv_refr_diff_band(lv_disp_buf_t * vdb, const lv_area_t * vdb_area_p, const lv_area_t * band_p,
+                              bool last)
+{
+    /*The beginning of the VDB may hold the previous band*/
+    lv_refr_wait_flush(vdb);
+
+    lv_color_t * buf  = vdb->buf_act;
+    lv_color_t * dest = buf;
+    lv_coord_t w      = lv_area_get_width(vdb_area_p);
+    lv_coord_t band_w = lv_area_get_width(band_p);
+    lv_coord_t y;
+
+    for(y = band_p->y1; y <= band_p->y2; y++) {
+        lv_color_t * src = &buf[(y - vdb_area_p->y1) * w + band_p->x1 - vdb_area_p->x1];
+        if(dest != src) memmove(dest, src, band_w * sizeof(lv_color_t));
+        dest += band_w;
+    }
+
+    /*The driver may keep the area until the flush is ready*/
+    lv_area_copy(&vdb->area, band_p);
+    lv_refr_flush_part(&vdb->area, buf, last);
+}
+
+/**
+ * Wait until the display driver is ready with the flushing
+ * @param vdb pointer to the display buffer being flushed
+ */
+static void lv_refr_wait_flush(lv_disp_buf_t * vdb)
+{
+    /*Acquire: pairs with the release in `lv_disp_flush_ready`*/
+    while(__atomic_load_n(&vdb->flushing, __ATOMIC_ACQUIRE)) {
+        if(disp_refr->driver.wait_cb) disp_refr->driver.wait_cb(&disp_refr->driver);
+    }
+}
+
+#if LV_LAYER_CACHE_SIZE
+/**
+ * Render the invalid layers which will be drawn in this refresh.
+ * Only if they weren't changed since the last refresh, to skip objects which change continuously.
+ */
+static void lv_refr_layers(void)
+{
+    /*The layers are drawn as color maps*/
+    if(lv_refr_buf_native() == false) return;
+
+    lv_layer_cache_entry_t * entry = lv_layer_cache_get_next(NULL);
+    while(entry != NULL) {
+        if(entry->changed) {
+            entry->changed = 0;
+        } else if(lv_refr_layer_valid(entry) == false && lv_refr_layer_needed(entry->obj) &&
+                  lv_refr_layer_fits(entry->obj)) {
+            lv_refr_layer_render(entry);
+        }
+        entry = lv_layer_cache_get_next(entry);
+    }
+}
+
+/**
+ * Render an object, its children and its parent behind it into its layer
+ * @param entry pointer to the cache entry of the object
+ */
+static void lv_refr_layer_render(lv_layer_cache_entry_t * entry)
+{
+    lv_obj_t * obj = entry->obj;
+    if(lv_layer_cache_alloc(entry, lv_area_get_size(&obj->coords)) == false) return;
+
+    /*Render into the layer instead of the VDB. No other thread renders now.*/
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
+    void * buf_act      = vdb->buf_act;
+    lv_area_t vdb_area;
+    lv_area_copy(&vdb_area, &vdb->area);
+    vdb->buf_act = entry->buf;
+    lv_area_copy(&vdb->area, &obj->coords);
+
+    layer_p        = obj;
+    lv_obj_t * par = lv_obj_get_parent(obj);
+    par->design_cb(par, &obj->coords, LV_DESIGN_DRAW_MAIN);
+    lv_refr_obj(obj, &obj->coords);
+    layer_p = NULL;
+
+    vdb->buf_act = buf_act;
+    lv_area_copy(&vdb->area, &vdb_area);
+
+    lv_area_copy(&entry->area, &obj->coords);
+    entry->opa_scale = lv_obj_get_opa_scale(obj);
+    entry->valid     = 1;
+}
+
+/**
+ * Check if an object will be drawn in this refresh
+ * @param obj pointer to an object
+ * @return true: `obj` is visible on the display and on an invalid area
+ */
+static bool lv_refr_layer_needed(lv_obj_t * obj)
+{
+    lv_obj_t * scr = lv_obj_get_screen(obj);
+    if(scr != lv_disp_get_scr_act(disp_refr) && scr != lv_disp_get_layer_top(disp_refr) &&
+       scr != lv_disp_get_layer_sys(disp_refr)) {
+        return false;
+    }
+
+    const lv_obj_t * par;
+    for(par = obj; par != NULL; par = lv_obj_get_parent(par)) {
+        if(par->hidden != 0) return false;
+    }
+
+    uint32_t i;
+    for(i = 0; i < disp_refr->inv_p; i++) {
+        if(disp_refr->inv_area_joined[i] == 0 && lv_area_is_on(&disp_refr->inv_areas[i], &obj->coords)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Check if a layer can hold everything visible on an object: it's on an opaque parent and no
+ * older sibling is drawn between them
+ * @param obj pointer to an object
+ * @return true: `obj` can be drawn from its layer
+ */
+static bool lv_refr_layer_fits(lv_obj_t * obj)
+{
+    lv_obj_t * par = lv_obj_get_parent(obj);
+    if(par == NULL || obj->ext_draw_pad != 0 || lv_refr_obj_opaque(par, &obj->coords) == false) return false;
+
+    /*The older siblings are drawn before the object*/
+    lv_obj_t * i = lv_ll_get_next(&par->child_ll, obj);
+    while(i != NULL) {
+        lv_area_t i_area;
+        lv_obj_get_coords(i, &i_area);
+        i_area.x1 -= i->ext_draw_pad;
+        i_area.y1 -= i->ext_draw_pad;
+        i_area.x2 += i->ext_draw_pad;
+        i_area.y2 += i->ext_draw_pad;
+        if(i->hidden == 0 && lv_area_is_on(&i_area, &obj->coords)) return false;
+
+        i = lv_ll_get_next(&par->child_ll, i);
+    }
+
+    return true;
+}
+
+/**
+ * Check if the layer of a cached object shows how the object would be drawn now
+ * @param entry pointer to the cache entry of the object
+ * @return true: the object can be drawn from its layer
+ */
+static bool lv_refr_layer_valid(const lv_layer_cache_entry_t * entry)
+{
+    lv_obj_t * obj = entry->obj;
+
+    return entry->valid && entry->area.x1 == obj->coords.x1 && entry->area.y1 == obj->coords.y1 &&
+           entry->area.x2 == obj->coords.x2 && entry->area.y2 == obj->coords.y2 &&
+           entry->opa_scale == lv_obj_get_opa_scale(obj) && lv_refr_layer_fits(obj);
+}
+#endif
+
+#if LV_REFR_MOVE_CNT
+/**
+ * Copy the moved objects on the display to their new position.
+ * Only the exposed areas and what can't be copied are invalidated.
+ */
+static void lv_refr_moves(void)
+{
+    uint8_t move_cnt = disp_refr->move_cnt;
+    if(move_cnt == 0) return;
+    disp_refr->move_cnt = 0;
+
+    lv_disp_move_t * moves = disp_refr->moves;
+    lv_area_t src[LV_REFR_MOVE_CNT];  /*Visible part of the object on the old position*/
+    lv_area_t dest[LV_REFR_MOVE_CNT]; /*Visible part of the object on the new position*/
+    lv_area_t copy[LV_REFR_MOVE_CNT]; /*Part of `dest` which can be copied from `src`*/
+    bool ok[LV_REFR_MOVE_CNT];
+
+    uint8_t i;
+    uint8_t j;
+    for(i = 0; i < move_cnt; i++) {
+        ok[i] = lv_refr_move_areas(&moves[i], &src[i], &dest[i], &copy[i]);
+    }
+
+    /*The copies mustn't overwrite the source of each other*/
+    for(i = 0; i < move_cnt; i++) {
+        for(j = i + 1; j < move_cnt; j++) {
+            if(lv_area_is_on(&moves[i].src, &moves[j].src) || lv_area_is_on(&moves[i].src, &moves[j].dest) ||
+               lv_area_is_on(&moves[i].dest, &moves[j].src) || lv_area_is_on(&moves[i].dest, &moves[j].dest)) {
+                ok[i] = false;
+                ok[j] = false;
+            }
+        }
+    }
+
+    /*Wait for the last flush, the display can't be changed until it's ready*/
+    lv_refr_wait_flush(lv_disp_get_buf(disp_refr));
+
+    uint16_t inv_p = disp_refr->inv_p;
+    for(i = 0; i < move_cnt; i++) {
+        lv_disp_move_t * move = &moves[i];
+        if(ok[i]) {
+            lv_area_t copy_src;
+            lv_coord_t x_ofs = move->dest.x1 - move->src.x1;
+            lv_coord_t y_ofs = move->dest.y1 - move->src.y1;
+            copy_src.x1      = copy[i].x1 - x_ofs;
+            copy_src.y1      = copy[i].y1 - y_ofs;
+            copy_src.x2      = copy[i].x2 - x_ofs;
+            copy_src.y2      = copy[i].y2 - y_ofs;
+            if(lv_disp_is_true_double_buf(disp_refr)) {
+                /*Copy in the buffer to flush, the other one gets it when they are synchronized*/
+                uint8_t * buf_act = (uint8_t *)lv_disp_get_buf(disp_refr)->buf_act;
+                lv_refr_buf_copy(buf_act, buf_act, &copy[i], &copy_src);
+                lv_area_copy(&disp_refr->copied[disp_refr->copied_cnt], &copy[i]);
+                disp_refr->copied_cnt++;
+            } else {
+                ok[i] = disp_refr->driver.copy_cb(&disp_refr->driver, &copy[i], &copy_src);
+                if(ok[i]) lv_refr_diff_copy(&copy[i], &copy_src);
+            }
+        }
+
+        if(ok[i] == false) {
+            lv_inv_area(disp_refr, &move->src);
+            lv_inv_area(disp_refr, &move->dest);
+            continue;
+        }
+
+        /*The invalid parts of the source are copied too, invalidate them on the new position*/
+        uint16_t a;
+        for(a = 0; a < inv_p; a++) {
+            lv_area_t inv_area;
+            if(lv_area_intersect(&inv_area, &disp_refr->inv_areas[a], &src[i]) == false) continue;
+
+            inv_area.x1 += move->dest.x1 - move->src.x1;
+            inv_area.y1 += move->dest.y1 - move->src.y1;
+            inv_area.x2 += move->dest.x1 - move->src.x1;
+            inv_area.y2 += move->dest.y1 - move->src.y1;
+            if(lv_area_intersect(&inv_area, &inv_area, &copy[i])) lv_inv_area(disp_refr, &inv_area);
+        }
+
+        /*Redraw what's exposed on the old position and what couldn't be copied to the new one*/
+        lv_refr_inv_diff(disp_refr, &src[i], &copy[i]);
+        lv_refr_inv_diff(disp_refr, &dest[i], &copy[i]);
+    }
+}
+
+/**
+ * Get the areas to copy for a move
+ * @param move pointer to a move
+ * @param src_p store the visible part of the object on the old position here
+ * @param dest_p store the visible part of the object on the new position here
+ * @param copy_p store the part of `dest_p` which can be copied here
+ * @return true: the copy shows the object correctly; false: it has to be redrawn
+ */
+static bool lv_refr_move_areas(const lv_disp_move_t * move, lv_area_t * src_p, lv_area_t * dest_p,
+                               lv_area_t * copy_p)
+{
+    lv_obj_t * obj = move->obj;
+
+    /*Changed since it was moved?*/
+    if(obj->coords.x1 != move->dest.x1 || obj->coords.y1 != move->dest.y1 || obj->coords.x2 != move->dest.x2 ||
+       obj->coords.y2 != move->dest.y2 || obj->ext_draw_pad != 0) {
+        return false;
+    }
+
+    /*The transparent parts would copy what's behind the object*/
+    if(lv_refr_obj_opaque(obj, &obj->coords) == false) return false;
+
+    /*The object is seen only on its parents and the screen*/
+    lv_area_t clip;
+    clip.x1 = 0;
+    clip.y1 = 0;
+    clip.x2 = lv_disp_get_hor_res(disp_refr) - 1;
+    clip.y2 = lv_disp_get_ver_res(disp_refr) - 1;
+
+    lv_obj_t * par;
+    for(par = lv_obj_get_parent(obj); par != NULL; par = lv_obj_get_parent(par)) {
+        if(par->hidden != 0 || lv_area_intersect(&clip, &clip, &par->coords) == false) return false;
+
+        /*Other types can draw on their children (e.g. the scrollbars of a page)*/
+        lv_obj_type_t type;
+        lv_obj_get_type(par, &type);
+        if(strcmp(type.type[0], "lv_obj") != 0 && strcmp(type.type[0], "lv_cont") != 0) return false;
+    }
+
+    bool src_ok  = lv_area_intersect(src_p, &move->src, &clip);
+    bool dest_ok = lv_area_intersect(dest_p, &move->dest, &clip);
+    if(src_ok == false || dest_ok == false) return false;
+
+    /*The visible part of the old position on the new position*/
+    copy_p->x1 = src_p->x1 + move->dest.x1 - move->src.x1;
+    copy_p->y1 = src_p->y1 + move->dest.y1 - move->src.y1;
+    copy_p->x2 = src_p->x2 + move->dest.x1 - move->src.x1;
+    copy_p->y2 = src_p->y2 + move->dest.y1 - move->src.y1;
+    if(lv_area_intersect(copy_p, copy_p, dest_p) == false) return false;
+
+    /*Nothing may be drawn on the object*/
+    return lv_refr_obj_on_top(obj, src_p) && lv_refr_obj_on_top(obj, dest_p);
+}
+
+/**
+ * Check if no other object is drawn after an object on an area
+ * @param obj pointer to an object
+ * @param area_p pointer to an area
+ * @return true: `obj` is on top on `area_p`
+ */
+static bool lv_refr_obj_on_top(lv_obj_t * obj, const lv_area_t * area_p)
+{
+    /*The younger siblings of the object and its parents are drawn later*/
+    lv_obj_t * i   = obj;
+    lv_obj_t * par = lv_obj_get_parent(i);
+    while(par != NULL) {
+        if(lv_refr_list_on(&par->child_ll, lv_ll_get_prev(&par->child_ll, i), area_p)) return false;
+
+        i   = par;
+        par = lv_obj_get_parent(i);
+    }
+
+    /*Then the top and system layers*/
+    lv_obj_t * top = lv_disp_get_layer_top(disp_refr);
+    lv_obj_t * sys = lv_disp_get_layer_sys(disp_refr);
+    if(i == lv_disp_get_scr_act(disp_refr)) {
+        if(lv_refr_list_on(&top->child_ll, lv_ll_get_tail(&top->child_ll), area_p)) return false;
+    } else if(i != top && i != sys) {
+        return false; /*Not on this display*/
+    }
+
+    if(i != sys && lv_refr_list_on(&sys->child_ll, lv_ll_get_tail(&sys->child_ll), area_p)) return false;
+
+    return true;
+}
+
+/**
+ * Check if any visible object of a children list is on an area
+ * @param ll_p pointer to a children list
+ * @param first_p the oldest object to check, the younger ones are checked too
+ * @param area_p pointer to an area
+ * @return true: an object is drawn on `area_p`
+ */
+static bool lv_refr_list_on(lv_ll_t * ll_p, lv_obj_t * first_p, const lv_area_t * area_p)
+{
+    lv_obj_t * i;
+    for(i = first_p; i != NULL; i = lv_ll_get_prev(ll_p, i)) {
+        lv_area_t i_area;
+        lv_obj_get_coords(i, &i_area);
+        i_area.x1 -= i->ext_draw_pad;
+        i_area.y1 -= i->ext_draw_pad;
+        i_area.x2 += i->ext_draw_pad;
+        i_area.y2 += i->ext_draw_pad;
+        if(i->hidden == 0 && lv_area_is_on(&i_area, area_p)) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Copy an area of a screen sized buffer of true double buffering
+ * @param dest_buf the buffer to copy to
+ * @param src_buf the buffer to copy from, may be `dest_buf`
+ * @param dest_p pointer to the area to copy to
+ * @param src_p pointer to the area to copy, same size as `dest_p`
+ */
+static void lv_refr_buf_copy(uint8_t * dest_buf, const uint8_t * src_buf, const lv_area_t * dest_p,
+                             const lv_area_t * src_p)
+{
+    lv_coord_t hres      = lv_disp_get_hor_res(disp_refr);
+    uint32_t line_length = lv_area_get_width(src_p) * sizeof(lv_color_t);
+    lv_coord_t h         = lv_area_get_height(src_p);
+    lv_coord_t i;
+
+    /*Copy the rows in the order which doesn't overwrite the ones not copied yet*/
+    for(i = 0; i < h; i++) {
+        lv_coord_t row = dest_p->y1 > src_p->y1 ? h - 1 - i : i;
+        memmove(&dest_buf[((dest_p->y1 + row) * hres + dest_p->x1) * sizeof(lv_color_t)],
+                &src_buf[((src_p->y1 + row) * hres + src_p->x1) * sizeof(lv_color_t)], line_length);
+    }
+}
+
+/**
+ * Copy an area of the last flushed frame like `copy_cb` copied it on the display
+ * @param dest_p pointer to the area to copy to
+ * @param src_p pointer to the area to copy, same size as `dest_p`
+ */
+static void lv_refr_diff_copy(const lv_area_t * dest_p, const lv_area_t * src_p)
+{
+    lv_color_t * diff_buf = disp_refr->driver.diff_buf;
+    if(diff_buf == NULL) return;
+
+    lv_coord_t hres      = lv_disp_get_hor_res(disp_refr);
+    uint32_t line_length = lv_area_get_width(src_p) * sizeof(lv_color_t);
+    lv_coord_t h         = lv_area_get_height(src_p);
+    lv_coord_t i;
+
+    /*Copy the rows in the order which doesn't overwrite the ones not copied yet*/
+    for(i = 0; i < h; i++) {
+        lv_coord_t row = dest_p->y1 > src_p->y1 ? h - 1 - i : i;
+        memmove(&diff_buf[(dest_p->y1 + row) * hres + dest_p->x1], &diff_buf[(src_p->y1 + row) * hres + src_p->x1],
+                line_length);
+    }
+}
+
+/**
+ * Invalidate the part of an area outside of an other area
+ * @param disp pointer to a display
+ * @param a1 pointer to the area to invalidate
+ * @param a2 pointer to the area not to invalidate
+ */
+static void lv_refr_inv_diff(lv_disp_t * disp, const lv_area_t * a1, const lv_area_t * a2)
+{
+    lv_area_t com;
+    if(lv_area_intersect(&com, a1, a2) == false) {
+        lv_inv_area(disp, a1);
+        return;
+    }
+    a2 = &com;
+
+    lv_area_t tmp;
+
+    /*Above and below the full width, then left and right*/
+    if(a2->y1 > a1->y1) {
+        lv_area_set(&tmp, a1->x1, a1->y1, a1->x2, a2->y1 - 1);
+        lv_inv_area(disp, &tmp);
+    }
+    if(a2->y2 < a1->y2) {
+        lv_area_set(&tmp, a1->x1, a2->y2 + 1, a1->x2, a1->y2);
+        lv_inv_area(disp, &tmp);
+    }
+    if(a2->x1 > a1->x1) {
+        lv_area_set(&tmp, a1->x1, a2->y1, a2->x1 - 1, a2->y2);
+        lv_inv_area(disp, &tmp);
+    }
+    if(a2->x2 < a1->x2) {
+        lv_area_set(&tmp, a2->x2 + 1, a2->y1, a1->x2, a2->y2);
+        lv_inv_area(disp, &tmp);
+    }
+}
+#endif
@@ -20,6 +20,34 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#ifndef LV_REFR_THREADS
+#define LV_REFR_THREADS 1
+#endif
+
+/*Focused objects are drawn with swapped styles and the group's shared temporary style*/
+#if LV_REFR_THREADS > 1 && LV_USE_GROUP
+#error "LV_REFR_THREADS > 1 requires LV_USE_GROUP 0. Check it in lv_conf.h"
+#endif
+
+#ifndef LV_REFR_MIN_BAND_ROWS
+#define LV_REFR_MIN_BAND_ROWS 16
+#endif
+
+#ifndef LV_REFR_AREA_COST
+#define LV_REFR_AREA_COST 0
+#endif
+
+#ifndef LV_REFR_CULL
+#define LV_REFR_CULL 0
+#endif
+
+/*State of the drawing functions which is kept per rendering thread*/
+#if LV_REFR_THREADS > 1
+#define LV_REFR_TLS _Thread_local
+#else
+#define LV_REFR_TLS
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -45,6 +73,13 @@ extern "C" {
  */
 void lv_refr_init(void);
 
+/**
+ * Deinitialize the screen refresh subsystem.
+ * Stop the rendering threads and free the draw buffers.
+ * Call it from the task handler thread when nothing is being refreshed.
+ */
+void lv_refr_deinit(void);
+
 /**
  * Redraw the invalidated areas now.
  * Normally the redrawing is periodically executed in `lv_task_handler` but a long blocking process
@@ -62,6 +97,32 @@ void lv_refr_now(lv_disp_t * disp);
  */
 void lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p);
 
+/**
+ * Copy the drawn pixels of an object to its new position in the next refresh instead of redrawing
+ * its old and new area. Needs the `copy_cb` of the display driver, with true double buffering the
+ * pixels are copied in the buffers.
+ * Call it before the coordinates of the object are changed.
+ * @param obj pointer to an object which is moved
+ * @param x_ofs horizontal movement
+ * @param y_ofs vertical movement
+ * @return true: the move is saved, `obj` needn't be invalidated; false: invalidate `obj` as usual
+ */
+bool lv_refr_move(lv_obj_t * obj, lv_coord_t x_ofs, lv_coord_t y_ofs);
+
+/**
+ * Forget the saved moves of an object (e.g. because it's deleted) and invalidate its areas instead
+ * @param obj pointer to an object
+ */
+void lv_refr_move_cancel(const lv_obj_t * obj);
+
+/**
+ * Render the layers of the cached objects on a screen which aren't valid, e.g. before the screen is
+ * loaded. Normally a layer is rendered when its object is drawn and wasn't changed since the last refresh.
+ * Call it from the task handler thread.
+ * @param scr pointer to a screen
+ */
+void lv_refr_render_layers(lv_obj_t * scr);
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -76,6 +137,18 @@ lv_disp_t * lv_refr_get_disp_refreshing(void);
  */
 void lv_refr_set_disp_refreshing(lv_disp_t * disp);
 
+/**
+ * Serialize drawing code which is not reentrant, e.g. code which temporally
+ * modifies an object or uses a shared cache.
+ * Does nothing if `LV_REFR_THREADS <= 1`. Must not be nested.
+ */
+void lv_refr_lock(void);
+
+/**
+ * Release the lock taken with `lv_refr_lock`
+ */
+void lv_refr_unlock(void);
+
 /**
  * Called periodically to handle the refreshing
  * @param task pointer to the task itself
@@ -9,7 +9,9 @@
 
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdlib.h>
 #include "lv_draw.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_log.h"
 #include "../lv_misc/lv_math.h"
@@ -36,6 +38,11 @@
  *  STATIC VARIABLES
  **********************/
 static uint32_t draw_buf_size = 0;
+#if LV_REFR_THREADS > 1
+/*Each rendering thread has its own buffer. `lv_mem` is not thread safe, use the C library*/
+static LV_REFR_TLS void * thread_buf;
+static LV_REFR_TLS uint32_t thread_buf_size;
+#endif
 
 /**********************
  *      MACROS
@@ -52,6 +59,15 @@ static uint32_t draw_buf_size = 0;
  */
 void * lv_draw_get_buf(uint32_t size)
 {
+#if LV_REFR_THREADS > 1
+    if(size <= thread_buf_size) return thread_buf;
+
+    void * buf = realloc(thread_buf, size);
+    lv_mem_assert(buf);
+    thread_buf      = buf;
+    thread_buf_size = size;
+    return thread_buf;
+#else
     if(size <= draw_buf_size) return LV_GC_ROOT(_lv_draw_buf);
 
     LV_LOG_TRACE("lv_draw_get_buf: allocate");
@@ -67,6 +83,7 @@ void * lv_draw_get_buf(uint32_t size)
     LV_GC_ROOT(_lv_draw_buf) = lv_mem_realloc(LV_GC_ROOT(_lv_draw_buf), size);
     lv_mem_assert(LV_GC_ROOT(_lv_draw_buf));
     return LV_GC_ROOT(_lv_draw_buf);
+#endif
 }
 
 /**
@@ -74,6 +91,12 @@ void * lv_draw_get_buf(uint32_t size)
  */
 void lv_draw_free_buf(void)
 {
+#if LV_REFR_THREADS > 1
+    free(thread_buf);
+    thread_buf      = NULL;
+    thread_buf_size = 0;
+#endif
+
     if(LV_GC_ROOT(_lv_draw_buf)) {
         lv_mem_free(LV_GC_ROOT(_lv_draw_buf));
         LV_GC_ROOT(_lv_draw_buf) = NULL;
@@ -1,6 +1,7 @@
 
 $(call define-srcs, littlevgl-lvgl-lvdraw, LittlevGL/lvgl/src/lv_draw, \
 	lv_draw_basic.c \
+	lv_draw_blend.c \
 	lv_draw.c \
 	lv_draw_rect.c \
 	lv_draw_label.c \
@@ -45,11 +45,18 @@ static void sw_mem_blend(lv_color_t * dest, const lv_color_t * src, uint32_t len
 static void sw_color_fill(lv_color_t * mem, lv_coord_t mem_width, const lv_area_t * fill_area, lv_color_t color,
                           lv_opa_t opa);
 
+static void map_unpack_alpha(lv_color_t * px_buf, lv_opa_t * opa_buf, const uint8_t * map_p, lv_coord_t w,
+                             lv_opa_t opa);
+static void map_chroma_key(lv_opa_t * opa_buf, const lv_color_t * px_p, lv_coord_t w, lv_color_t key);
+
 static inline lv_color_t color_mix_2_alpha(lv_color_t bg_color, lv_opa_t bg_opa, lv_color_t fg_color, lv_opa_t fg_opa);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+/*A row of pixels and their opacities prepared to be blended at once*/
+static LV_REFR_TLS LV_ATTRIBUTE_MEM_ALIGN lv_color_t px_buf[LV_HOR_RES_MAX];
+static LV_REFR_TLS lv_opa_t opa_buf[LV_HOR_RES_MAX];
 
 /**********************
  *      MACROS
@@ -86,7 +93,9 @@ void lv_draw_px(lv_coord_t x, lv_coord_t y, const lv_area_t * mask_p, lv_color_t
     x -= vdb->area.x1;
     y -= vdb->area.y1;
 
-    if(disp->driver.set_px_cb) {
+    if(disp->driver.fill_span_cb) {
+        disp->driver.fill_span_cb(&disp->driver, (uint8_t *)vdb->buf_act, vdb_width, x, y, 1, color, opa);
+    } else if(disp->driver.set_px_cb) {
         disp->driver.set_px_cb(&disp->driver, (uint8_t *)vdb->buf_act, vdb_width, x, y, color, opa);
     } else {
         bool scr_transp = false;
@@ -151,8 +160,8 @@ void lv_draw_fill(const lv_area_t * cords_p, const lv_area_t * mask_p, lv_color_
     vdb_buf_tmp += vdb_width * vdb_rel_a.y1;
 
 #if LV_USE_GPU
-    static LV_ATTRIBUTE_MEM_ALIGN lv_color_t color_array_tmp[LV_HOR_RES_MAX]; /*Used by 'lv_disp_mem_blend'*/
-    static lv_coord_t last_width = -1;
+    static LV_REFR_TLS LV_ATTRIBUTE_MEM_ALIGN lv_color_t color_array_tmp[LV_HOR_RES_MAX]; /*Used by 'lv_disp_mem_blend'*/
+    static LV_REFR_TLS lv_coord_t last_width = -1;
 
     lv_coord_t w = lv_area_get_width(&vdb_rel_a);
     /*Don't use hw. acc. for every small fill (because of the init overhead)*/
@@ -321,7 +330,13 @@ void lv_draw_letter(const lv_point_t * pos_p, const lv_area_t * mask_p, const lv
     scr_transp = disp->driver.screen_transp;
 #endif
 
+    /*Collect the opacities of a row and blend them at once with the span callback*/
+    bool span = disp->driver.blend_span_cb != NULL && col_end > col_start && col_end - col_start <= LV_HOR_RES_MAX;
+    if(span) lv_blend_fill(px_buf, col_end - col_start, color);
+
     for(row = row_start; row < row_end; row++) {
+        if(span) memset(opa_buf, LV_OPA_TRANSP, col_end - col_start);
+
         bitmask = bitmask_init >> col_bit;
         for(col = col_start; col < col_end; col++) {
             letter_px = (*map_p & bitmask) >> (8 - col_bit - g.bpp);
@@ -333,7 +348,9 @@ void lv_draw_letter(const lv_point_t * pos_p, const lv_area_t * mask_p, const lv
                                         : (uint16_t)((uint16_t)bpp_opa_table[letter_px] * opa) >> 8;
                 }
 
-                if(disp->driver.set_px_cb) {
+                if(span) {
+                    opa_buf[col - col_start] = px_opa;
+                } else if(disp->driver.set_px_cb) {
                     disp->driver.set_px_cb(&disp->driver, (uint8_t *)vdb->buf_act, vdb_width,
                                            (col + pos_x) - vdb->area.x1, (row + pos_y) - vdb->area.y1, color, px_opa);
                 } else if(vdb_buf_tmp->full != color.full) {
@@ -362,6 +379,12 @@ void lv_draw_letter(const lv_point_t * pos_p, const lv_area_t * mask_p, const lv
                 map_p++;
             }
         }
+        if(span) {
+            disp->driver.blend_span_cb(&disp->driver, (uint8_t *)vdb->buf_act, vdb_width,
+                                       (col_start + pos_x) - vdb->area.x1, (row + pos_y) - vdb->area.y1,
+                                       col_end - col_start, px_buf, opa_buf);
+        }
+
         col_bit += ((g.box_w - col_end) + col_start) * g.bpp;
 
         map_p += (col_bit >> 3);
@@ -433,8 +456,12 @@ void lv_draw_map(const lv_area_t * cords_p, const lv_area_t * mask_p, const uint
     scr_transp = disp->driver.screen_transp;
 #endif
 
+    /*Write the rows with the span callback of the driver if it has one*/
+    bool span = disp->driver.blend_span_cb != NULL && map_useful_w <= LV_HOR_RES_MAX;
+
     /*The simplest case just copy the pixels into the VDB*/
-    if(chroma_key == false && alpha_byte == false && opa == LV_OPA_COVER && recolor_opa == LV_OPA_TRANSP) {
+    if(chroma_key == false && alpha_byte == false && opa == LV_OPA_COVER && recolor_opa == LV_OPA_TRANSP &&
+       span == false) {
 
         /*Use the custom VDB write function is exists*/
         if(disp->driver.set_px_cb) {
@@ -466,7 +493,42 @@ void lv_draw_map(const lv_area_t * cords_p, const lv_area_t * mask_p, const uint
         }
     }
 
-    /*In the other cases every pixel need to be checked one-by-one*/
+    /*In the other cases prepare a row of pixels and their opacities, then blend it at once*/
+    else if(span || (disp->driver.set_px_cb == NULL && scr_transp == false && map_useful_w <= LV_HOR_RES_MAX)) {
+        for(row = masked_a.y1; row <= masked_a.y2; row++) {
+            const lv_color_t * px_p = (const lv_color_t *)map_p;
+
+            if(alpha_byte) {
+                map_unpack_alpha(px_buf, opa_buf, map_p, map_useful_w, opa);
+                px_p = px_buf;
+            } else if(chroma_key) {
+                memset(opa_buf, opa, map_useful_w);
+            }
+
+            /*The chroma key is compared to the original color of the pixels*/
+            if(chroma_key) map_chroma_key(opa_buf, px_p, map_useful_w, disp->driver.color_chroma_key);
+
+            if(recolor_opa != LV_OPA_TRANSP) {
+                if(px_p != px_buf) memcpy(px_buf, px_p, map_useful_w * sizeof(lv_color_t));
+                lv_blend_fill_opa(px_buf, map_useful_w, recolor, recolor_opa);
+                px_p = px_buf;
+            }
+
+            if(span) {
+                if(alpha_byte == false && chroma_key == false) memset(opa_buf, opa, map_useful_w);
+                disp->driver.blend_span_cb(&disp->driver, (uint8_t *)vdb->buf_act, vdb_width, masked_a.x1, row,
+                                           map_useful_w, px_p, opa_buf);
+            } else if(alpha_byte || chroma_key) {
+                lv_blend_map_alpha(vdb_buf_tmp, px_p, opa_buf, map_useful_w);
+            } else {
+                lv_blend_map(vdb_buf_tmp, px_p, map_useful_w, opa);
+            }
+
+            map_p += map_width * px_size_byte; /*Next row on the map*/
+            vdb_buf_tmp += vdb_width;          /*Next row on the VDB*/
+        }
+    }
+    /*With custom VDB write or transparent screen every pixel need to be checked one-by-one*/
     else {
 
         lv_coord_t col;
@@ -564,14 +626,7 @@ void lv_draw_map(const lv_area_t * cords_p, const lv_area_t * mask_p, const uint
  */
 static void sw_mem_blend(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa)
 {
-    if(opa == LV_OPA_COVER) {
-        memcpy(dest, src, length * sizeof(lv_color_t));
-    } else {
-        uint32_t col;
-        for(col = 0; col < length; col++) {
-            dest[col] = lv_color_mix(src[col], dest[col], opa);
-        }
-    }
+    lv_blend_map(dest, src, length, opa);
 }
 
 /**
@@ -590,9 +645,15 @@ static void sw_color_fill(lv_color_t * mem, lv_coord_t mem_width, const lv_area_
     lv_coord_t col;
 
     lv_disp_t * disp = lv_refr_get_disp_refreshing();
-    if(disp->driver.set_px_cb) {
-        for(col = fill_area->x1; col <= fill_area->x2; col++) {
-            for(row = fill_area->y1; row <= fill_area->y2; row++) {
+    if(disp->driver.fill_span_cb) {
+        for(row = fill_area->y1; row <= fill_area->y2; row++) {
+            disp->driver.fill_span_cb(&disp->driver, (uint8_t *)mem, mem_width, fill_area->x1, row,
+                                      fill_area->x2 - fill_area->x1 + 1, color, opa);
+        }
+    } else if(disp->driver.set_px_cb) {
+        /*Row by row to write the buffer in order*/
+        for(row = fill_area->y1; row <= fill_area->y2; row++) {
+            for(col = fill_area->x1; col <= fill_area->x2; col++) {
                 disp->driver.set_px_cb(&disp->driver, (uint8_t *)mem, mem_width, col, row, color, opa);
             }
         }
@@ -603,9 +664,7 @@ static void sw_color_fill(lv_color_t * mem, lv_coord_t mem_width, const lv_area_
         if(opa == LV_OPA_COVER) {
 
             /*Fill the first row with 'color'*/
-            for(col = fill_area->x1; col <= fill_area->x2; col++) {
-                mem[col] = color;
-            }
+            lv_blend_fill(&mem[fill_area->x1], fill_area->x2 - fill_area->x1 + 1, color);
 
             /*Copy the first row to all other rows*/
             lv_color_t * mem_first = &mem[fill_area->x1];
@@ -624,24 +683,15 @@ static void sw_color_fill(lv_color_t * mem, lv_coord_t mem_width, const lv_area_
             scr_transp = disp->driver.screen_transp;
 #endif
 
-            lv_color_t bg_tmp  = LV_COLOR_BLACK;
-            lv_color_t opa_tmp = lv_color_mix(color, bg_tmp, opa);
             for(row = fill_area->y1; row <= fill_area->y2; row++) {
-                for(col = fill_area->x1; col <= fill_area->x2; col++) {
-                    if(scr_transp == false) {
-                        /*If the bg color changed recalculate the result color*/
-                        if(mem[col].full != bg_tmp.full) {
-                            bg_tmp  = mem[col];
-                            opa_tmp = lv_color_mix(color, bg_tmp, opa);
-                        }
-
-                        mem[col] = opa_tmp;
-
-                    } else {
+                if(scr_transp == false) {
+                    lv_blend_fill_opa(&mem[fill_area->x1], fill_area->x2 - fill_area->x1 + 1, color, opa);
+                } else {
 #if LV_COLOR_DEPTH == 32
+                    for(col = fill_area->x1; col <= fill_area->x2; col++) {
                         mem[col] = color_mix_2_alpha(mem[col], mem[col].ch.alpha, color, opa);
-#endif
                     }
+#endif
                 }
                 mem += mem_width;
             }
@@ -649,6 +699,48 @@ static void sw_color_fill(lv_color_t * mem, lv_coord_t mem_width, const lv_area_
     }
 }
 
+/**
+ * Separate a row of an image with alpha byte to colors and opacities
+ * @param px_buf store the colors here
+ * @param opa_buf store the opacities here, already scaled with `opa`
+ * @param map_p pointer to the first pixel of the row
+ * @param w number of pixels
+ * @param opa opacity of the image
+ */
+static void map_unpack_alpha(lv_color_t * px_buf, lv_opa_t * opa_buf, const uint8_t * map_p, lv_coord_t w,
+                             lv_opa_t opa)
+{
+    lv_coord_t col;
+    for(col = 0; col < w; col++) {
+        const uint8_t * px_color_p = &map_p[(uint32_t)col * LV_IMG_PX_SIZE_ALPHA_BYTE];
+#if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
+        px_buf[col].full = px_color_p[0];
+#elif LV_COLOR_DEPTH == 16
+        /*Because of Alpha byte 16 bit color can start on odd address which can cause crash*/
+        px_buf[col].full = px_color_p[0] + (px_color_p[1] << 8);
+#elif LV_COLOR_DEPTH == 32
+        memcpy(&px_buf[col], px_color_p, sizeof(lv_color_t));
+#endif
+        lv_opa_t px_opa = px_color_p[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+        opa_buf[col]    = px_opa == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)px_opa * opa) >> 8;
+    }
+}
+
+/**
+ * Make the pixels with the chroma key color transparent
+ * @param opa_buf opacities of the pixels
+ * @param px_p colors of the pixels
+ * @param w number of pixels
+ * @param key the chroma key color
+ */
+static void map_chroma_key(lv_opa_t * opa_buf, const lv_color_t * px_p, lv_coord_t w, lv_color_t key)
+{
+    lv_coord_t col;
+    for(col = 0; col < w; col++) {
+        opa_buf[col] = px_p[col].full == key.full ? LV_OPA_TRANSP : opa_buf[col];
+    }
+}
+
 /**
  * Mix two colors. Both color can have alpha value. It requires ARGB888 colors.
  * @param bg_color background color
@@ -677,11 +769,11 @@ static inline lv_color_t color_mix_2_alpha(lv_color_t bg_color, lv_opa_t bg_opa,
     /*Both colors have alpha. Expensive calculation need to be applied*/
     else {
         /*Save the parameters and the result. If they will be asked again don't compute again*/
-        static lv_opa_t fg_opa_save     = 0;
-        static lv_opa_t bg_opa_save     = 0;
-        static lv_color_t fg_color_save = {{0}};
-        static lv_color_t bg_color_save = {{0}};
-        static lv_color_t c             = {{0}};
+        static LV_REFR_TLS lv_opa_t fg_opa_save     = 0;
+        static LV_REFR_TLS lv_opa_t bg_opa_save     = 0;
+        static LV_REFR_TLS lv_color_t fg_color_save = {{0}};
+        static LV_REFR_TLS lv_color_t bg_color_save = {{0}};
+        static LV_REFR_TLS lv_color_t c             = {{0}};
 
         if(fg_opa != fg_opa_save || bg_opa != bg_opa_save || fg_color.full != fg_color_save.full ||
            bg_color.full != bg_color_save.full) {
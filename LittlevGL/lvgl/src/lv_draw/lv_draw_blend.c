@@ -0,0 +1,421 @@
+/**
+ * @file lv_draw_blend.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_blend.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#ifndef LV_DRAW_SIMD
+#define LV_DRAW_SIMD 0
+#endif
+
+/*The vector kernels work on RGB565 and ARGB8888 pixels*/
+#if LV_DRAW_SIMD && ((LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0) || LV_COLOR_DEPTH == 32)
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define LV_BLEND_NEON 1
+#elif defined(__SSE2__)
+#define LV_BLEND_SSE2 1
+#endif
+#endif
+
+#ifndef LV_BLEND_NEON
+#define LV_BLEND_NEON 0
+#endif
+
+#ifndef LV_BLEND_SSE2
+#define LV_BLEND_SSE2 0
+#endif
+
+#define LV_BLEND_VECTOR (LV_BLEND_NEON || LV_BLEND_SSE2)
+
+#if LV_BLEND_NEON
+#include <arm_neon.h>
+#define LV_BLEND_STEP 8 /*Pixels in a vector*/
+#elif LV_BLEND_SSE2
+#include <emmintrin.h>
+#define LV_BLEND_STEP (16 / sizeof(lv_color_t)) /*Pixels in a vector*/
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*A vector of `LV_BLEND_STEP` pixels and one of their opacities*/
+#if LV_BLEND_NEON && LV_COLOR_DEPTH == 16
+typedef uint16x8_t px_vec_t;
+typedef uint16x8_t mix_vec_t;
+#elif LV_BLEND_NEON && LV_COLOR_DEPTH == 32
+typedef uint8x8x4_t px_vec_t; /*The channels of the pixels in separate vectors*/
+typedef uint8x8_t mix_vec_t;
+#elif LV_BLEND_SSE2
+typedef __m128i px_vec_t;
+typedef __m128i mix_vec_t; /*16 bit color: per pixel, 32 bit color: per channel*/
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_BLEND_VECTOR
+static inline px_vec_t px_load(const lv_color_t * src);
+static inline void px_store(lv_color_t * dest, px_vec_t px);
+static inline px_vec_t px_set(lv_color_t color);
+static inline mix_vec_t mix_set(lv_opa_t opa);
+static inline mix_vec_t mix_load(const lv_opa_t * alpha);
+static inline px_vec_t px_mix(px_vec_t fg, px_vec_t bg, mix_vec_t mix);
+static inline px_vec_t px_select(px_vec_t res, px_vec_t fg, px_vec_t bg, mix_vec_t mix);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Fill pixels with a color
+ * @param dest pointer to the first pixel to fill
+ * @param length number of pixels
+ * @param color fill color
+ */
+void lv_blend_fill(lv_color_t * dest, uint32_t length, lv_color_t color)
+{
+    uint32_t i = 0;
+
+#if LV_BLEND_VECTOR
+    px_vec_t color_vec = px_set(color);
+    for(; i + LV_BLEND_STEP <= length; i += LV_BLEND_STEP) {
+        px_store(&dest[i], color_vec);
+    }
+#endif
+
+    for(; i < length; i++) {
+        dest[i] = color;
+    }
+}
+
+/**
+ * Mix a color to pixels with an opacity. Gives the same result as `lv_color_mix`.
+ * @param dest pointer to the first pixel to mix to
+ * @param length number of pixels
+ * @param color color to mix
+ * @param opa opacity of `color`
+ */
+void lv_blend_fill_opa(lv_color_t * dest, uint32_t length, lv_color_t color, lv_opa_t opa)
+{
+    uint32_t i = 0;
+
+#if LV_BLEND_VECTOR
+    px_vec_t color_vec = px_set(color);
+    mix_vec_t mix      = mix_set(opa);
+    for(; i + LV_BLEND_STEP <= length; i += LV_BLEND_STEP) {
+        px_store(&dest[i], px_mix(color_vec, px_load(&dest[i]), mix));
+    }
+#endif
+
+    /*Areas of one color are common, mix only if the background changes*/
+    lv_color_t bg_tmp  = LV_COLOR_BLACK;
+    lv_color_t opa_tmp = lv_color_mix(color, bg_tmp, opa);
+    for(; i < length; i++) {
+        if(dest[i].full != bg_tmp.full) {
+            bg_tmp  = dest[i];
+            opa_tmp = lv_color_mix(color, bg_tmp, opa);
+        }
+        dest[i] = opa_tmp;
+    }
+}
+
+/**
+ * Blend pixels to other ones with an opacity. Gives the same result as `lv_color_mix`.
+ * @param dest pointer to the first pixel to blend to
+ * @param src pointer to the pixels to blend
+ * @param length number of pixels
+ * @param opa opacity of `src` (LV_OPA_COVER: copy)
+ */
+void lv_blend_map(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa)
+{
+    if(opa == LV_OPA_COVER) {
+        memcpy(dest, src, length * sizeof(lv_color_t));
+        return;
+    }
+
+    uint32_t i = 0;
+
+#if LV_BLEND_VECTOR
+    mix_vec_t mix = mix_set(opa);
+    for(; i + LV_BLEND_STEP <= length; i += LV_BLEND_STEP) {
+        px_store(&dest[i], px_mix(px_load(&src[i]), px_load(&dest[i]), mix));
+    }
+#endif
+
+    for(; i < length; i++) {
+        dest[i] = lv_color_mix(src[i], dest[i], opa);
+    }
+}
+
+/**
+ * Blend pixels to other ones with an opacity of each pixel. Gives the same result as `lv_color_mix`
+ * but LV_OPA_TRANSP pixels are skipped and LV_OPA_COVER pixels are copied.
+ * @param dest pointer to the first pixel to blend to
+ * @param src pointer to the pixels to blend
+ * @param alpha pointer to the opacity of each pixel of `src`
+ * @param length number of pixels
+ */
+void lv_blend_map_alpha(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * alpha, uint32_t length)
+{
+    uint32_t i = 0;
+
+#if LV_BLEND_VECTOR
+    for(; i + LV_BLEND_STEP <= length; i += LV_BLEND_STEP) {
+        px_vec_t fg   = px_load(&src[i]);
+        px_vec_t bg   = px_load(&dest[i]);
+        mix_vec_t mix = mix_load(&alpha[i]);
+        px_store(&dest[i], px_select(px_mix(fg, bg, mix), fg, bg, mix));
+    }
+#endif
+
+    for(; i < length; i++) {
+        if(alpha[i] == LV_OPA_TRANSP) continue;
+
+        if(alpha[i] == LV_OPA_COVER)
+            dest[i] = src[i];
+        else
+            dest[i] = lv_color_mix(src[i], dest[i], alpha[i]);
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/* Every kernel computes `(fg * mix + bg * (255 - mix)) >> 8` for each channel like
+ * `lv_color_mix`. The products fit into 16 bits, so 16 bit lanes give the same result.*/
+
+#if LV_BLEND_NEON && LV_COLOR_DEPTH == 16
+
+static inline px_vec_t px_load(const lv_color_t * src)
+{
+    return vld1q_u16((const uint16_t *)src);
+}
+
+static inline void px_store(lv_color_t * dest, px_vec_t px)
+{
+    vst1q_u16((uint16_t *)dest, px);
+}
+
+static inline px_vec_t px_set(lv_color_t color)
+{
+    return vdupq_n_u16(color.full);
+}
+
+static inline mix_vec_t mix_set(lv_opa_t opa)
+{
+    return vdupq_n_u16(opa);
+}
+
+static inline mix_vec_t mix_load(const lv_opa_t * alpha)
+{
+    return vmovl_u8(vld1_u8(alpha));
+}
+
+static inline px_vec_t px_mix(px_vec_t fg, px_vec_t bg, mix_vec_t mix)
+{
+    uint16x8_t inv    = vsubq_u16(vdupq_n_u16(255), mix);
+    uint16x8_t g_mask = vdupq_n_u16(0x3F);
+    uint16x8_t b_mask = vdupq_n_u16(0x1F);
+
+    uint16x8_t r = vmlaq_u16(vmulq_u16(vshrq_n_u16(fg, 11), mix), vshrq_n_u16(bg, 11), inv);
+    uint16x8_t g = vmlaq_u16(vmulq_u16(vandq_u16(vshrq_n_u16(fg, 5), g_mask), mix),
+                             vandq_u16(vshrq_n_u16(bg, 5), g_mask), inv);
+    uint16x8_t b = vmlaq_u16(vmulq_u16(vandq_u16(fg, b_mask), mix), vandq_u16(bg, b_mask), inv);
+
+    r = vshlq_n_u16(vshrq_n_u16(r, 8), 11);
+    g = vshlq_n_u16(vshrq_n_u16(g, 8), 5);
+    b = vshrq_n_u16(b, 8);
+
+    return vorrq_u16(vorrq_u16(r, g), b);
+}
+
+static inline px_vec_t px_select(px_vec_t res, px_vec_t fg, px_vec_t bg, mix_vec_t mix)
+{
+    res = vbslq_u16(vceqq_u16(mix, vdupq_n_u16(LV_OPA_COVER)), fg, res);
+    return vbslq_u16(vceqq_u16(mix, vdupq_n_u16(LV_OPA_TRANSP)), bg, res);
+}
+
+#elif LV_BLEND_NEON && LV_COLOR_DEPTH == 32
+
+static inline px_vec_t px_load(const lv_color_t * src)
+{
+    return vld4_u8((const uint8_t *)src);
+}
+
+static inline void px_store(lv_color_t * dest, px_vec_t px)
+{
+    vst4_u8((uint8_t *)dest, px);
+}
+
+static inline px_vec_t px_set(lv_color_t color)
+{
+    px_vec_t px;
+    px.val[0] = vdup_n_u8(color.ch.blue);
+    px.val[1] = vdup_n_u8(color.ch.green);
+    px.val[2] = vdup_n_u8(color.ch.red);
+    px.val[3] = vdup_n_u8(color.ch.alpha);
+    return px;
+}
+
+static inline mix_vec_t mix_set(lv_opa_t opa)
+{
+    return vdup_n_u8(opa);
+}
+
+static inline mix_vec_t mix_load(const lv_opa_t * alpha)
+{
+    return vld1_u8(alpha);
+}
+
+static inline px_vec_t px_mix(px_vec_t fg, px_vec_t bg, mix_vec_t mix)
+{
+    uint8x8_t inv = vsub_u8(vdup_n_u8(255), mix);
+    px_vec_t res;
+    uint8_t c;
+    for(c = 0; c < 3; c++) {
+        res.val[c] = vshrn_n_u16(vmlal_u8(vmull_u8(fg.val[c], mix), bg.val[c], inv), 8);
+    }
+    res.val[3] = vdup_n_u8(0xFF);
+
+    return res;
+}
+
+static inline px_vec_t px_select(px_vec_t res, px_vec_t fg, px_vec_t bg, mix_vec_t mix)
+{
+    uint8x8_t cover  = vceq_u8(mix, vdup_n_u8(LV_OPA_COVER));
+    uint8x8_t transp = vceq_u8(mix, vdup_n_u8(LV_OPA_TRANSP));
+    uint8_t c;
+    for(c = 0; c < 4; c++) {
+        res.val[c] = vbsl_u8(transp, bg.val[c], vbsl_u8(cover, fg.val[c], res.val[c]));
+    }
+
+    return res;
+}
+
+#elif LV_BLEND_SSE2
+
+static inline px_vec_t px_load(const lv_color_t * src)
+{
+    return _mm_loadu_si128((const __m128i *)src);
+}
+
+static inline void px_store(lv_color_t * dest, px_vec_t px)
+{
+    _mm_storeu_si128((__m128i *)dest, px);
+}
+
+#if LV_COLOR_DEPTH == 16
+
+static inline px_vec_t px_set(lv_color_t color)
+{
+    return _mm_set1_epi16((int16_t)color.full);
+}
+
+static inline mix_vec_t mix_set(lv_opa_t opa)
+{
+    return _mm_set1_epi16(opa);
+}
+
+static inline mix_vec_t mix_load(const lv_opa_t * alpha)
+{
+    return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)alpha), _mm_setzero_si128());
+}
+
+static inline px_vec_t px_mix(px_vec_t fg, px_vec_t bg, mix_vec_t mix)
+{
+    __m128i inv    = _mm_sub_epi16(_mm_set1_epi16(255), mix);
+    __m128i g_mask = _mm_set1_epi16(0x3F);
+    __m128i b_mask = _mm_set1_epi16(0x1F);
+
+    __m128i r = _mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(fg, 11), mix),
+                              _mm_mullo_epi16(_mm_srli_epi16(bg, 11), inv));
+    __m128i g = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(fg, 5), g_mask), mix),
+                              _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(bg, 5), g_mask), inv));
+    __m128i b = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(fg, b_mask), mix),
+                              _mm_mullo_epi16(_mm_and_si128(bg, b_mask), inv));
+
+    r = _mm_slli_epi16(_mm_srli_epi16(r, 8), 11);
+    g = _mm_slli_epi16(_mm_srli_epi16(g, 8), 5);
+    b = _mm_srli_epi16(b, 8);
+
+    return _mm_or_si128(_mm_or_si128(r, g), b);
+}
+
+static inline px_vec_t px_select(px_vec_t res, px_vec_t fg, px_vec_t bg, mix_vec_t mix)
+{
+    __m128i cover  = _mm_cmpeq_epi16(mix, _mm_set1_epi16(LV_OPA_COVER));
+    __m128i transp = _mm_cmpeq_epi16(mix, _mm_setzero_si128());
+    res            = _mm_or_si128(_mm_and_si128(cover, fg), _mm_andnot_si128(cover, res));
+    return _mm_or_si128(_mm_and_si128(transp, bg), _mm_andnot_si128(transp, res));
+}
+
+#else /*LV_COLOR_DEPTH == 32*/
+
+static inline px_vec_t px_set(lv_color_t color)
+{
+    return _mm_set1_epi32((int32_t)color.full);
+}
+
+static inline mix_vec_t mix_set(lv_opa_t opa)
+{
+    return _mm_set1_epi8((char)opa);
+}
+
+static inline mix_vec_t mix_load(const lv_opa_t * alpha)
+{
+    /*Repeat the opacity of each pixel for its 4 channels*/
+    int32_t a4;
+    memcpy(&a4, alpha, sizeof(a4));
+    __m128i mix = _mm_cvtsi32_si128(a4);
+    mix         = _mm_unpacklo_epi8(mix, mix);
+    return _mm_unpacklo_epi16(mix, mix);
+}
+
+static inline px_vec_t px_mix(px_vec_t fg, px_vec_t bg, mix_vec_t mix)
+{
+    __m128i zero    = _mm_setzero_si128();
+    __m128i max     = _mm_set1_epi16(255);
+    __m128i mix_lo  = _mm_unpacklo_epi8(mix, zero);
+    __m128i mix_hi  = _mm_unpackhi_epi8(mix, zero);
+
+    __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(fg, zero), mix_lo),
+                               _mm_mullo_epi16(_mm_unpacklo_epi8(bg, zero), _mm_sub_epi16(max, mix_lo)));
+    __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(fg, zero), mix_hi),
+                               _mm_mullo_epi16(_mm_unpackhi_epi8(bg, zero), _mm_sub_epi16(max, mix_hi)));
+
+    __m128i res = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+    return _mm_or_si128(res, _mm_set1_epi32((int32_t)0xFF000000));
+}
+
+static inline px_vec_t px_select(px_vec_t res, px_vec_t fg, px_vec_t bg, mix_vec_t mix)
+{
+    /*The opacity is repeated for the 4 channels, so the byte masks select whole pixels*/
+    __m128i cover  = _mm_cmpeq_epi8(mix, _mm_set1_epi8((char)LV_OPA_COVER));
+    __m128i transp = _mm_cmpeq_epi8(mix, _mm_setzero_si128());
+    res            = _mm_or_si128(_mm_and_si128(cover, fg), _mm_andnot_si128(cover, res));
+    return _mm_or_si128(_mm_and_si128(transp, bg), _mm_andnot_si128(transp, res));
+}
+
+#endif /*LV_COLOR_DEPTH*/
+
+#endif /*LV_BLEND_SSE2*/
@@ -0,0 +1,81 @@
+/**
+ * @file lv_draw_blend.h
+ *
+ */
+
+#ifndef LV_DRAW_BLEND_H
+#define LV_DRAW_BLEND_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_CONF_INCLUDE_SIMPLE
+#include "lv_conf.h"
+#else
+#include "../../../lv_conf.h"
+#endif
+
+#include <stdint.h>
+#include "../lv_misc/lv_color.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Fill pixels with a color
+ * @param dest pointer to the first pixel to fill
+ * @param length number of pixels
+ * @param color fill color
+ */
+void lv_blend_fill(lv_color_t * dest, uint32_t length, lv_color_t color);
+
+/**
+ * Mix a color to pixels with an opacity. Gives the same result as `lv_color_mix`.
+ * @param dest pointer to the first pixel to mix to
+ * @param length number of pixels
+ * @param color color to mix
+ * @param opa opacity of `color`
+ */
+void lv_blend_fill_opa(lv_color_t * dest, uint32_t length, lv_color_t color, lv_opa_t opa);
+
+/**
+ * Blend pixels to other ones with an opacity. Gives the same result as `lv_color_mix`.
+ * @param dest pointer to the first pixel to blend to
+ * @param src pointer to the pixels to blend
+ * @param length number of pixels
+ * @param opa opacity of `src` (LV_OPA_COVER: copy)
+ */
+void lv_blend_map(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa);
+
+/**
+ * Blend pixels to other ones with an opacity of each pixel. Gives the same result as `lv_color_mix`
+ * but LV_OPA_TRANSP pixels are skipped and LV_OPA_COVER pixels are copied.
+ * @param dest pointer to the first pixel to blend to
+ * @param src pointer to the pixels to blend
+ * @param alpha pointer to the opacity of each pixel of `src`
+ * @param length number of pixels
+ */
+void lv_blend_map_alpha(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * alpha, uint32_t length);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_BLEND_H*/
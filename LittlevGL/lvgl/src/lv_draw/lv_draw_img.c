@@ -8,6 +8,7 @@
  *********************/
 #include "lv_draw_img.h"
 #include "lv_img_cache.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_log.h"
 
 /*********************
@@ -444,26 +445,39 @@ static lv_res_t lv_img_draw_core(const lv_area_t * coords, const lv_area_t * mas
     lv_opa_t opa =
         opa_scale == LV_OPA_COVER ? style->image.opa : (uint16_t)((uint16_t)style->image.opa * opa_scale) >> 8;
 
+    /*The image cache and the decoders are shared by the rendering threads.
+     * Lock them only while the cache entry is used*/
+    lv_refr_lock();
     lv_img_cache_entry_t * cdsc = lv_img_cache_open(src, style);
 
-    if(cdsc == NULL) return LV_RES_INV;
+    if(cdsc == NULL) {
+        lv_refr_unlock();
+        return LV_RES_INV;
+    }
+
+    bool chroma_keyed        = lv_img_color_format_is_chroma_keyed(cdsc->dec_dsc.header.cf);
+    bool alpha_byte          = lv_img_color_format_has_alpha(cdsc->dec_dsc.header.cf);
+    const char * error_msg   = cdsc->dec_dsc.error_msg;
+    const uint8_t * img_data = cdsc->dec_dsc.img_data;
 
-    bool chroma_keyed = lv_img_color_format_is_chroma_keyed(cdsc->dec_dsc.header.cf);
-    bool alpha_byte   = lv_img_color_format_has_alpha(cdsc->dec_dsc.header.cf);
+    /*The pixels of variables stay valid even if an other thread drops the image from the cache*/
+    if(error_msg != NULL || (img_data != NULL && lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE)) {
+        lv_refr_unlock();
+    }
 
-    if(cdsc->dec_dsc.error_msg != NULL) {
+    if(error_msg != NULL) {
         LV_LOG_WARN("Image draw error");
         lv_draw_rect(coords, mask, &lv_style_plain, LV_OPA_COVER);
-        lv_draw_label(coords, mask, &lv_style_plain, LV_OPA_COVER, cdsc->dec_dsc.error_msg, LV_TXT_FLAG_NONE, NULL, -1,
-                      -1, NULL);
+        lv_draw_label(coords, mask, &lv_style_plain, LV_OPA_COVER, error_msg, LV_TXT_FLAG_NONE, NULL, -1, -1, NULL);
     }
     /* The decoder open could open the image and gave the entire uncompressed image.
      * Just draw it!*/
-    else if(cdsc->dec_dsc.img_data) {
-        lv_draw_map(coords, mask, cdsc->dec_dsc.img_data, opa, chroma_keyed, alpha_byte, style->image.color,
-                    style->image.intense);
+    else if(img_data) {
+        lv_draw_map(coords, mask, img_data, opa, chroma_keyed, alpha_byte, style->image.color, style->image.intense);
+        if(lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) lv_refr_unlock();
     }
-    /* The whole uncompressed image is not available. Try to read it line-by-line*/
+    /* The whole uncompressed image is not available. Try to read it line-by-line.
+     * The decoder keeps its state in the cache entry so it stays locked*/
     else {
         lv_coord_t width = lv_area_get_width(&mask_com);
 
@@ -480,6 +494,7 @@ static lv_res_t lv_img_draw_core(const lv_area_t * coords, const lv_area_t * mas
             read_res = lv_img_decoder_read_line(&cdsc->dec_dsc, x, y, width, buf);
             if(read_res != LV_RES_OK) {
                 lv_img_decoder_close(&cdsc->dec_dsc);
+                lv_refr_unlock();
                 LV_LOG_WARN("Image draw can't read the line");
                 return LV_RES_INV;
             }
@@ -488,6 +503,7 @@ static lv_res_t lv_img_draw_core(const lv_area_t * coords, const lv_area_t * mas
             line.y2++;
             y++;
         }
+        lv_refr_unlock();
     }
 
     return LV_RES_OK;
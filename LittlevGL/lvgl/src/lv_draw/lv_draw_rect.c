@@ -6,6 +6,7 @@
 /*********************
  *      INCLUDES
  *********************/
+#include <string.h>
 #include "lv_draw_rect.h"
 #include "../lv_misc/lv_circ.h"
 #include "../lv_misc/lv_math.h"
@@ -24,9 +25,53 @@
 /*Add extra radius with LV_SHADOW_BOTTOM to cover anti-aliased corners*/
 #define SHADOW_BOTTOM_AA_EXTRA_RADIUS 3
 
+#if LV_DRAW_CORNER_CACHE_CNT
+/*Side length of the largest corner mask (a shadow with `radius + width == LV_DRAW_CORNER_CACHE_MAX_R`)*/
+#define CORNER_MASK_SIZE_MAX (2 * LV_DRAW_CORNER_CACHE_MAX_R + 19)
+
+/*The corners are recorded with this color to tell apart the pixels drawn with the color mixed to itself*/
+#define CORNER_REC_COLOR LV_COLOR_WHITE
+
+#define CORNER_TYPE_MAIN 0
+#define CORNER_TYPE_BORDER 1
+#define CORNER_TYPE_SHADOW_FULL 2
+#define CORNER_TYPE_SHADOW_BOTTOM 3
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_DRAW_CORNER_CACHE_CNT
+/*Columns of a row of a corner mask. [first, run_start) and [run_end, last) are blended pixel by pixel,
+ * [run_start, run_end) has the opacity of the middle column and is filled on the whole width*/
+typedef struct
+{
+    uint16_t first;
+    uint16_t run_start;
+    uint16_t run_end;
+    uint16_t last;
+} lv_draw_corner_row_t;
+
+/*Opacity of the corners of the smallest rectangle whose corners don't touch (see `corner_mask_size`).
+ * The middle column and row stand for the middle of a larger rectangle.
+ * The middle row of solid rectangles and borders has to be empty.*/
+typedef struct
+{
+    uint32_t last_use; /*Value of `corner_clock` when last drawn, 0: free entry*/
+    uint16_t radius;   /*Corrected radius*/
+    lv_coord_t width;  /*Border or shadow width*/
+    lv_coord_t size;   /*Side length of the mask*/
+    lv_coord_t ext;    /*The mask reaches this far out of the rectangle*/
+    lv_opa_t opa;
+    uint8_t type : 2;
+    uint8_t aa : 1;
+    uint8_t part : 5;
+    uint8_t valid : 1; /*0: can't be drawn from the mask, e.g. pixels are drawn twice*/
+    lv_draw_corner_row_t rows[CORNER_MASK_SIZE_MAX];
+    lv_opa_t map[CORNER_MASK_SIZE_MAX * CORNER_MASK_SIZE_MAX];
+    uint8_t mixed[(CORNER_MASK_SIZE_MAX * CORNER_MASK_SIZE_MAX + 7) >> 3]; /*Bit 1: the color mixed to itself*/
+} lv_draw_corner_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -52,6 +97,22 @@ static void lv_draw_shadow_full_straight(const lv_area_t * coords, const lv_area
 #endif
 
 static uint16_t lv_draw_cont_radius_corr(uint16_t r, lv_coord_t w, lv_coord_t h);
+static void corner_px(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_color_t color, lv_opa_t opa);
+static void corner_fill(const lv_area_t * coords, const lv_area_t * mask, lv_color_t color, lv_opa_t opa);
+
+#if LV_DRAW_CORNER_CACHE_CNT
+static bool corner_cache_draw(uint8_t type, const lv_area_t * coords, const lv_area_t * mask,
+                              const lv_style_t * style, lv_opa_t opa_scale);
+static lv_coord_t corner_mask_size(uint8_t type, uint16_t radius, bool aa, lv_coord_t width, lv_coord_t * ext);
+static lv_draw_corner_t * corner_cache_get(uint8_t type, uint16_t radius, bool aa, lv_opa_t opa, lv_coord_t width,
+                                           uint8_t part);
+static void corner_rec_fill(const lv_area_t * coords, const lv_area_t * mask, lv_color_t color, lv_opa_t opa);
+static void corner_rows_init(lv_draw_corner_t * corner);
+static void corner_blit(const lv_draw_corner_t * corner, const lv_area_t * coords, const lv_area_t * mask,
+                        lv_color_t color);
+static void corner_blit_span(const lv_draw_corner_t * corner, uint32_t map_i, lv_coord_t x, lv_coord_t y,
+                             lv_coord_t len, const lv_area_t * mask, const lv_color_t * colors);
+#endif
 
 #if LV_ANTIALIAS
 static lv_opa_t antialias_get_opa_circ(lv_coord_t seg, lv_coord_t px_id, lv_opa_t opa);
@@ -60,10 +121,17 @@ static lv_opa_t antialias_get_opa_circ(lv_coord_t seg, lv_coord_t px_id, lv_opa_
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_DRAW_CORNER_CACHE_CNT
+/*Every rendering thread has its own cache as objects can be drawn while holding `lv_refr_lock`*/
+static LV_REFR_TLS lv_draw_corner_t corner_cache[LV_DRAW_CORNER_CACHE_CNT];
+static LV_REFR_TLS uint32_t corner_clock;
+static LV_REFR_TLS lv_draw_corner_t * corner_rec; /*Record `corner_px/fill` to this mask instead of drawing*/
+#endif
 
 /**********************
  *      MACROS
  **********************/
+#define CORNER_MIXED(corner, i) (((corner)->mixed[(i) >> 3] >> ((i) & 0x7)) & 0x1)
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -194,6 +262,10 @@ static void lv_draw_rect_main_mid(const lv_area_t * coords, const lv_area_t * ma
 static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
                                      lv_opa_t opa_scale)
 {
+#if LV_DRAW_CORNER_CACHE_CNT
+    if(corner_cache_draw(CORNER_TYPE_MAIN, coords, mask, style, opa_scale)) return;
+#endif
+
     uint16_t radius = style->body.radius;
     bool aa         = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing());
 
@@ -282,27 +354,27 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
                         aa_opa = opa - lv_draw_aa_get_opa(seg_size, i, opa);
                     }
 
-                    lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
-                               aa_color_hor_bottom, aa_opa);
-                    lv_draw_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
-                               aa_color_hor_bottom, aa_opa);
-                    lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
-                               aa_color_hor_top, aa_opa);
-                    lv_draw_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
-                               aa_color_hor_top, aa_opa);
+                    corner_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
+                              aa_color_hor_bottom, aa_opa);
+                    corner_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
+                              aa_color_hor_bottom, aa_opa);
+                    corner_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
+                              aa_color_hor_top, aa_opa);
+                    corner_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
+                              aa_color_hor_top, aa_opa);
 
                     mix          = (uint32_t)((uint32_t)(radius - out_y_seg_start + i) * 255) / height;
                     aa_color_ver = lv_color_mix(mcolor, gcolor, mix);
-                    lv_draw_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
-                               aa_color_ver, aa_opa);
-                    lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
-                               aa_color_ver, aa_opa);
+                    corner_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
+                              aa_color_ver, aa_opa);
+                    corner_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
+                              aa_color_ver, aa_opa);
 
                     aa_color_ver = lv_color_mix(gcolor, mcolor, mix);
-                    lv_draw_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
-                               aa_color_ver, aa_opa);
-                    lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
-                               aa_color_ver, aa_opa);
+                    corner_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
+                              aa_color_ver, aa_opa);
+                    corner_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
+                              aa_color_ver, aa_opa);
                 }
 
                 out_x_last      = cir.x;
@@ -333,7 +405,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
                 mix       = (uint32_t)((uint32_t)(coords->y2 - edge_top_area.y1) * 255) / height;
                 act_color = lv_color_mix(mcolor, gcolor, mix);
             }
-            lv_draw_fill(&edge_top_area, mask, act_color, opa);
+            corner_fill(&edge_top_area, mask, act_color, opa);
         }
 
         if(mid_top_refr != 0) {
@@ -343,7 +415,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
                 mix       = (uint32_t)((uint32_t)(coords->y2 - mid_top_area.y1) * 255) / height;
                 act_color = lv_color_mix(mcolor, gcolor, mix);
             }
-            lv_draw_fill(&mid_top_area, mask, act_color, opa);
+            corner_fill(&mid_top_area, mask, act_color, opa);
         }
 
         if(mid_bot_refr != 0) {
@@ -353,7 +425,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
                 mix       = (uint32_t)((uint32_t)(coords->y2 - mid_bot_area.y1) * 255) / height;
                 act_color = lv_color_mix(mcolor, gcolor, mix);
             }
-            lv_draw_fill(&mid_bot_area, mask, act_color, opa);
+            corner_fill(&mid_bot_area, mask, act_color, opa);
         }
 
         if(edge_bot_refr != 0) {
@@ -364,7 +436,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
                 mix       = (uint32_t)((uint32_t)(coords->y2 - edge_bot_area.y1) * 255) / height;
                 act_color = lv_color_mix(mcolor, gcolor, mix);
             }
-            lv_draw_fill(&edge_bot_area, mask, act_color, opa);
+            corner_fill(&edge_bot_area, mask, act_color, opa);
         }
 
         /*Save the current coordinates*/
@@ -389,7 +461,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
         mix       = (uint32_t)((uint32_t)(coords->y2 - edge_top_area.y1) * 255) / height;
         act_color = lv_color_mix(mcolor, gcolor, mix);
     }
-    lv_draw_fill(&edge_top_area, mask, act_color, opa);
+    corner_fill(&edge_top_area, mask, act_color, opa);
 
     if(edge_top_area.y1 != mid_top_area.y1) {
 
@@ -399,7 +471,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
             mix       = (uint32_t)((uint32_t)(coords->y2 - mid_top_area.y1) * 255) / height;
             act_color = lv_color_mix(mcolor, gcolor, mix);
         }
-        lv_draw_fill(&mid_top_area, mask, act_color, opa);
+        corner_fill(&mid_top_area, mask, act_color, opa);
     }
 
     if(mcolor.full == gcolor.full)
@@ -408,7 +480,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
         mix       = (uint32_t)((uint32_t)(coords->y2 - mid_bot_area.y1) * 255) / height;
         act_color = lv_color_mix(mcolor, gcolor, mix);
     }
-    lv_draw_fill(&mid_bot_area, mask, act_color, opa);
+    corner_fill(&mid_bot_area, mask, act_color, opa);
 
     if(edge_bot_area.y1 != mid_bot_area.y1) {
 
@@ -418,7 +490,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
             mix       = (uint32_t)((uint32_t)(coords->y2 - edge_bot_area.y1) * 255) / height;
             act_color = lv_color_mix(mcolor, gcolor, mix);
         }
-        lv_draw_fill(&edge_bot_area, mask, act_color, opa);
+        corner_fill(&edge_bot_area, mask, act_color, opa);
     }
 
 #if LV_ANTIALIAS
@@ -428,11 +500,11 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
         edge_top_area.x2 = coords->x2 - radius - 2;
         edge_top_area.y1 = coords->y1;
         edge_top_area.y2 = coords->y1;
-        lv_draw_fill(&edge_top_area, mask, style->body.main_color, opa);
+        corner_fill(&edge_top_area, mask, style->body.main_color, opa);
 
         edge_top_area.y1 = coords->y2;
         edge_top_area.y2 = coords->y2;
-        lv_draw_fill(&edge_top_area, mask, style->body.grad_color, opa);
+        corner_fill(&edge_top_area, mask, style->body.grad_color, opa);
 
         /*Last parts of the anti-alias*/
         out_y_seg_end       = cir.y;
@@ -449,27 +521,27 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
         lv_coord_t i;
         for(i = 0; i < seg_size; i++) {
             lv_opa_t aa_opa = opa - lv_draw_aa_get_opa(seg_size, i, opa);
-            lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
-                       aa_color_hor_top, aa_opa);
-            lv_draw_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
-                       aa_color_hor_top, aa_opa);
-            lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
-                       aa_color_hor_bottom, aa_opa);
-            lv_draw_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
-                       aa_color_hor_bottom, aa_opa);
+            corner_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
+                      aa_color_hor_top, aa_opa);
+            corner_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
+                      aa_color_hor_top, aa_opa);
+            corner_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
+                      aa_color_hor_bottom, aa_opa);
+            corner_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
+                      aa_color_hor_bottom, aa_opa);
 
             mix          = (uint32_t)((uint32_t)(radius - out_y_seg_start + i) * 255) / height;
             aa_color_ver = lv_color_mix(mcolor, gcolor, mix);
-            lv_draw_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask, aa_color_ver,
-                       aa_opa);
-            lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask, aa_color_ver,
-                       aa_opa);
+            corner_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask, aa_color_ver,
+                      aa_opa);
+            corner_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask, aa_color_ver,
+                      aa_opa);
 
             aa_color_ver = lv_color_mix(gcolor, mcolor, mix);
-            lv_draw_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask, aa_color_ver,
-                       aa_opa);
-            lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask, aa_color_ver,
-                       aa_opa);
+            corner_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask, aa_color_ver,
+                      aa_opa);
+            corner_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask, aa_color_ver,
+                      aa_opa);
         }
 
         /*In some cases the last pixel is not drawn*/
@@ -482,14 +554,14 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
             aa_color_hor_bottom = lv_color_mix(mcolor, gcolor, mix);
 
             lv_opa_t aa_opa = opa >> 1;
-            lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p), rb_origo.y + LV_CIRC_OCT2_Y(aa_p), mask, aa_color_hor_bottom,
-                       aa_opa);
-            lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p), lb_origo.y + LV_CIRC_OCT4_Y(aa_p), mask, aa_color_hor_bottom,
-                       aa_opa);
-            lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p), lt_origo.y + LV_CIRC_OCT6_Y(aa_p), mask, aa_color_hor_top,
-                       aa_opa);
-            lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p), rt_origo.y + LV_CIRC_OCT8_Y(aa_p), mask, aa_color_hor_top,
-                       aa_opa);
+            corner_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p), rb_origo.y + LV_CIRC_OCT2_Y(aa_p), mask, aa_color_hor_bottom,
+                      aa_opa);
+            corner_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p), lb_origo.y + LV_CIRC_OCT4_Y(aa_p), mask, aa_color_hor_bottom,
+                      aa_opa);
+            corner_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p), lt_origo.y + LV_CIRC_OCT6_Y(aa_p), mask, aa_color_hor_top,
+                      aa_opa);
+            corner_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p), rt_origo.y + LV_CIRC_OCT8_Y(aa_p), mask, aa_color_hor_top,
+                      aa_opa);
         }
     }
 #endif
@@ -705,6 +777,10 @@ static void lv_draw_rect_border_straight(const lv_area_t * coords, const lv_area
 static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
                                        lv_opa_t opa_scale)
 {
+#if LV_DRAW_CORNER_CACHE_CNT
+    if(corner_cache_draw(CORNER_TYPE_BORDER, coords, mask, style, opa_scale)) return;
+#endif
+
     uint16_t radius       = style->body.radius;
     bool aa               = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing());
     lv_coord_t bwidth     = style->body.border.width;
@@ -804,31 +880,31 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
                     }
 
                     if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
-                        lv_draw_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
-                                   style->body.border.color, aa_opa);
-                        lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
-                                   style->body.border.color, aa_opa);
+                        corner_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
+                                  style->body.border.color, aa_opa);
+                        corner_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
+                                  style->body.border.color, aa_opa);
                     }
 
                     if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_LEFT)) {
-                        lv_draw_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
-                                   style->body.border.color, aa_opa);
-                        lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
-                                   style->body.border.color, aa_opa);
+                        corner_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
+                                  style->body.border.color, aa_opa);
+                        corner_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
+                                  style->body.border.color, aa_opa);
                     }
 
                     if((part & LV_BORDER_TOP) && (part & LV_BORDER_LEFT)) {
-                        lv_draw_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
-                                   style->body.border.color, aa_opa);
-                        lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
-                                   style->body.border.color, aa_opa);
+                        corner_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
+                                  style->body.border.color, aa_opa);
+                        corner_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
+                                  style->body.border.color, aa_opa);
                     }
 
                     if((part & LV_BORDER_TOP) && (part & LV_BORDER_RIGHT)) {
-                        lv_draw_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
-                                   style->body.border.color, aa_opa);
-                        lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
-                                   style->body.border.color, aa_opa);
+                        corner_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
+                                  style->body.border.color, aa_opa);
+                        corner_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
+                                  style->body.border.color, aa_opa);
                     }
                 }
 
@@ -857,45 +933,45 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
                     }
 
                     if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
-                        lv_draw_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) - 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
-                                   style->body.border.color, aa_opa);
+                        corner_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) - 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
+                                  style->body.border.color, aa_opa);
                     }
 
                     if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_LEFT)) {
-                        lv_draw_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) - 1, mask,
-                                   style->body.border.color, aa_opa);
+                        corner_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) - 1, mask,
+                                  style->body.border.color, aa_opa);
                     }
 
                     if((part & LV_BORDER_TOP) && (part & LV_BORDER_LEFT)) {
-                        lv_draw_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) + 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
-                                   style->body.border.color, aa_opa);
+                        corner_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) + 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
+                                  style->body.border.color, aa_opa);
                     }
 
                     if((part & LV_BORDER_TOP) && (part & LV_BORDER_RIGHT)) {
-                        lv_draw_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) + 1, mask,
-                                   style->body.border.color, aa_opa);
+                        corner_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) + 1, mask,
+                                  style->body.border.color, aa_opa);
                     }
 
                     /*Be sure the pixels on the middle are not drawn twice*/
                     if(LV_CIRC_OCT1_X(aa_p) - 1 != LV_CIRC_OCT2_X(aa_p) + i) {
                         if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
-                            lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) - 1,
-                                       mask, style->body.border.color, aa_opa);
+                            corner_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) - 1,
+                                      mask, style->body.border.color, aa_opa);
                         }
 
                         if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_LEFT)) {
-                            lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) + 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i,
-                                       mask, style->body.border.color, aa_opa);
+                            corner_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) + 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i,
+                                      mask, style->body.border.color, aa_opa);
                         }
 
                         if((part & LV_BORDER_TOP) && (part & LV_BORDER_LEFT)) {
-                            lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) + 1,
-                                       mask, style->body.border.color, aa_opa);
+                            corner_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) + 1,
+                                      mask, style->body.border.color, aa_opa);
                         }
 
                         if((part & LV_BORDER_TOP) && (part & LV_BORDER_RIGHT)) {
-                            lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) - 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i,
-                                       mask, style->body.border.color, aa_opa);
+                            corner_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) - 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i,
+                                      mask, style->body.border.color, aa_opa);
                         }
                     }
                 }
@@ -912,13 +988,13 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
             circ_area.x2 = rb_origo.x + LV_CIRC_OCT1_X(cir_out);
             circ_area.y1 = rb_origo.y + LV_CIRC_OCT1_Y(cir_out);
             circ_area.y2 = rb_origo.y + LV_CIRC_OCT1_Y(cir_out);
-            lv_draw_fill(&circ_area, mask, color, opa);
+            corner_fill(&circ_area, mask, color, opa);
 
             circ_area.x1 = rb_origo.x + LV_CIRC_OCT2_X(cir_out);
             circ_area.x2 = rb_origo.x + LV_CIRC_OCT2_X(cir_out);
             circ_area.y1 = rb_origo.y + LV_CIRC_OCT2_Y(cir_out) - act_w1;
             circ_area.y2 = rb_origo.y + LV_CIRC_OCT2_Y(cir_out);
-            lv_draw_fill(&circ_area, mask, color, opa);
+            corner_fill(&circ_area, mask, color, opa);
         }
 
         /*Draw the octets to the left bottom corner*/
@@ -927,13 +1003,13 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
             circ_area.x2 = lb_origo.x + LV_CIRC_OCT3_X(cir_out);
             circ_area.y1 = lb_origo.y + LV_CIRC_OCT3_Y(cir_out) - act_w2;
             circ_area.y2 = lb_origo.y + LV_CIRC_OCT3_Y(cir_out);
-            lv_draw_fill(&circ_area, mask, color, opa);
+            corner_fill(&circ_area, mask, color, opa);
 
             circ_area.x1 = lb_origo.x + LV_CIRC_OCT4_X(cir_out);
             circ_area.x2 = lb_origo.x + LV_CIRC_OCT4_X(cir_out) + act_w1;
             circ_area.y1 = lb_origo.y + LV_CIRC_OCT4_Y(cir_out);
             circ_area.y2 = lb_origo.y + LV_CIRC_OCT4_Y(cir_out);
-            lv_draw_fill(&circ_area, mask, color, opa);
+            corner_fill(&circ_area, mask, color, opa);
         }
 
         /*Draw the octets to the left top corner*/
@@ -944,14 +1020,14 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
                 circ_area.x2 = lt_origo.x + LV_CIRC_OCT5_X(cir_out) + act_w2;
                 circ_area.y1 = lt_origo.y + LV_CIRC_OCT5_Y(cir_out);
                 circ_area.y2 = lt_origo.y + LV_CIRC_OCT5_Y(cir_out);
-                lv_draw_fill(&circ_area, mask, color, opa);
+                corner_fill(&circ_area, mask, color, opa);
             }
 
             circ_area.x1 = lt_origo.x + LV_CIRC_OCT6_X(cir_out);
             circ_area.x2 = lt_origo.x + LV_CIRC_OCT6_X(cir_out);
             circ_area.y1 = lt_origo.y + LV_CIRC_OCT6_Y(cir_out);
             circ_area.y2 = lt_origo.y + LV_CIRC_OCT6_Y(cir_out) + act_w1;
-            lv_draw_fill(&circ_area, mask, color, opa);
+            corner_fill(&circ_area, mask, color, opa);
         }
 
         /*Draw the octets to the right top corner*/
@@ -960,7 +1036,7 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
             circ_area.x2 = rt_origo.x + LV_CIRC_OCT7_X(cir_out);
             circ_area.y1 = rt_origo.y + LV_CIRC_OCT7_Y(cir_out);
             circ_area.y2 = rt_origo.y + LV_CIRC_OCT7_Y(cir_out) + act_w2;
-            lv_draw_fill(&circ_area, mask, color, opa);
+            corner_fill(&circ_area, mask, color, opa);
 
             /*Don't draw if the lines are common in the middle*/
             if(rb_origo.y + LV_CIRC_OCT1_Y(cir_out) > rt_origo.y + LV_CIRC_OCT8_Y(cir_out)) {
@@ -968,7 +1044,7 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
                 circ_area.x2 = rt_origo.x + LV_CIRC_OCT8_X(cir_out);
                 circ_area.y1 = rt_origo.y + LV_CIRC_OCT8_Y(cir_out);
                 circ_area.y2 = rt_origo.y + LV_CIRC_OCT8_Y(cir_out);
-                lv_draw_fill(&circ_area, mask, color, opa);
+                corner_fill(&circ_area, mask, color, opa);
             }
         }
         lv_circ_next(&cir_out, &tmp_out);
@@ -994,31 +1070,31 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
         for(i = 0; i < seg_size; i++) {
             lv_opa_t aa_opa = opa - lv_draw_aa_get_opa(seg_size, i, opa);
             if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
-                lv_draw_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
-                           style->body.border.color, aa_opa);
-                lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
-                           style->body.border.color, aa_opa);
+                corner_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
+                          style->body.border.color, aa_opa);
+                corner_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_LEFT)) {
-                lv_draw_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
-                           style->body.border.color, aa_opa);
-                lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
-                           style->body.border.color, aa_opa);
+                corner_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
+                          style->body.border.color, aa_opa);
+                corner_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_TOP) && (part & LV_BORDER_LEFT)) {
-                lv_draw_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
-                           style->body.border.color, aa_opa);
-                lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
-                           style->body.border.color, aa_opa);
+                corner_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
+                          style->body.border.color, aa_opa);
+                corner_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_TOP) && (part & LV_BORDER_RIGHT)) {
-                lv_draw_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
-                           style->body.border.color, aa_opa);
-                lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
-                           style->body.border.color, aa_opa);
+                corner_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
+                          style->body.border.color, aa_opa);
+                corner_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
+                          style->body.border.color, aa_opa);
             }
         }
 
@@ -1030,23 +1106,23 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
             lv_opa_t aa_opa = opa >> 1;
 
             if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
-                lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p), rb_origo.y + LV_CIRC_OCT2_Y(aa_p), mask,
-                           style->body.border.color, aa_opa);
+                corner_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p), rb_origo.y + LV_CIRC_OCT2_Y(aa_p), mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_LEFT)) {
-                lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p), lb_origo.y + LV_CIRC_OCT4_Y(aa_p), mask,
-                           style->body.border.color, aa_opa);
+                corner_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p), lb_origo.y + LV_CIRC_OCT4_Y(aa_p), mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_TOP) && (part & LV_BORDER_LEFT)) {
-                lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p), lt_origo.y + LV_CIRC_OCT6_Y(aa_p), mask,
-                           style->body.border.color, aa_opa);
+                corner_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p), lt_origo.y + LV_CIRC_OCT6_Y(aa_p), mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_TOP) && (part & LV_BORDER_RIGHT)) {
-                lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p), rt_origo.y + LV_CIRC_OCT8_Y(aa_p), mask,
-                           style->body.border.color, aa_opa);
+                corner_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p), rt_origo.y + LV_CIRC_OCT8_Y(aa_p), mask,
+                          style->body.border.color, aa_opa);
             }
         }
 
@@ -1059,44 +1135,44 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
         for(i = 0; i < seg_size; i++) {
             lv_opa_t aa_opa = lv_draw_aa_get_opa(seg_size, i, opa);
             if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
-                lv_draw_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) - 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
-                           style->body.border.color, aa_opa);
+                corner_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) - 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_LEFT)) {
-                lv_draw_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) - 1, mask,
-                           style->body.border.color, aa_opa);
+                corner_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) - 1, mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_TOP) && (part & LV_BORDER_LEFT)) {
-                lv_draw_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) + 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
-                           style->body.border.color, aa_opa);
+                corner_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) + 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_TOP) && (part & LV_BORDER_RIGHT)) {
-                lv_draw_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) + 1, mask,
-                           style->body.border.color, aa_opa);
+                corner_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) + 1, mask,
+                          style->body.border.color, aa_opa);
             }
 
             if(LV_CIRC_OCT1_X(aa_p) - 1 != LV_CIRC_OCT2_X(aa_p) + i) {
                 if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
-                    lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) - 1, mask,
-                               style->body.border.color, aa_opa);
+                    corner_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) - 1, mask,
+                              style->body.border.color, aa_opa);
                 }
 
                 if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_LEFT)) {
-                    lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) + 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
-                               style->body.border.color, aa_opa);
+                    corner_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) + 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
+                              style->body.border.color, aa_opa);
                 }
 
                 if((part & LV_BORDER_TOP) && (part & LV_BORDER_LEFT)) {
-                    lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) + 1, mask,
-                               style->body.border.color, aa_opa);
+                    corner_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) + 1, mask,
+                              style->body.border.color, aa_opa);
                 }
 
                 if((part & LV_BORDER_TOP) && (part & LV_BORDER_RIGHT)) {
-                    lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) - 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
-                               style->body.border.color, aa_opa);
+                    corner_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) - 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
+                              style->body.border.color, aa_opa);
                 }
             }
         }
@@ -1144,6 +1220,9 @@ static void lv_draw_shadow(const lv_area_t * coords, const lv_area_t * mask, con
 static void lv_draw_shadow_full(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
                                 lv_opa_t opa_scale)
 {
+#if LV_DRAW_CORNER_CACHE_CNT
+    if(corner_cache_draw(CORNER_TYPE_SHADOW_FULL, coords, mask, style, opa_scale)) return;
+#endif
 
     /* KNOWN ISSUE
      * The algorithm calculates the shadow only above the middle point of the radius (speaking about
@@ -1278,19 +1357,19 @@ static void lv_draw_shadow_full(const lv_area_t * coords, const lv_area_t * mask
         for(d = 1; d < col; d++) {
 
             if(point_lt.x < ofs_lt.x && point_lt.y < ofs_lt.y) {
-                lv_draw_px(point_lt.x, point_lt.y, mask, style->body.shadow.color, line_2d_blur[d]);
+                corner_px(point_lt.x, point_lt.y, mask, style->body.shadow.color, line_2d_blur[d]);
             }
 
             if(point_lb.x < ofs_lb.x && point_lb.y > ofs_lb.y) {
-                lv_draw_px(point_lb.x, point_lb.y, mask, style->body.shadow.color, line_2d_blur[d]);
+                corner_px(point_lb.x, point_lb.y, mask, style->body.shadow.color, line_2d_blur[d]);
             }
 
             if(point_rt.x > ofs_rt.x && point_rt.y < ofs_rt.y) {
-                lv_draw_px(point_rt.x, point_rt.y, mask, style->body.shadow.color, line_2d_blur[d]);
+                corner_px(point_rt.x, point_rt.y, mask, style->body.shadow.color, line_2d_blur[d]);
             }
 
             if(point_rb.x > ofs_rb.x && point_rb.y > ofs_rb.y) {
-                lv_draw_px(point_rb.x, point_rb.y, mask, style->body.shadow.color, line_2d_blur[d]);
+                corner_px(point_rb.x, point_rb.y, mask, style->body.shadow.color, line_2d_blur[d]);
             }
 
             point_rb.x++;
@@ -1310,6 +1389,10 @@ static void lv_draw_shadow_full(const lv_area_t * coords, const lv_area_t * mask
 static void lv_draw_shadow_bottom(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
                                   lv_opa_t opa_scale)
 {
+#if LV_DRAW_CORNER_CACHE_CNT
+    if(corner_cache_draw(CORNER_TYPE_SHADOW_BOTTOM, coords, mask, style, opa_scale)) return;
+#endif
+
     bool aa           = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing());
     lv_coord_t radius = style->body.radius;
     lv_coord_t swidth = style->body.shadow.width;
@@ -1377,12 +1460,12 @@ static void lv_draw_shadow_bottom(const lv_area_t * coords, const lv_area_t * ma
             } else {
                 px_opa = (uint16_t)((uint16_t)line_1d_blur[d] + line_1d_blur[d - diff]) >> 1;
             }
-            lv_draw_px(point_l.x, point_l.y, mask, style->body.shadow.color, px_opa);
+            corner_px(point_l.x, point_l.y, mask, style->body.shadow.color, px_opa);
             point_l.y++;
 
             /*Don't overdraw the pixel on the middle*/
             if(point_r.x > ofs_l.x) {
-                lv_draw_px(point_r.x, point_r.y, mask, style->body.shadow.color, px_opa);
+                corner_px(point_r.x, point_r.y, mask, style->body.shadow.color, px_opa);
             }
             point_r.y++;
         }
@@ -1395,7 +1478,7 @@ static void lv_draw_shadow_bottom(const lv_area_t * coords, const lv_area_t * ma
 
     uint16_t d;
     for(d = 0; d < swidth; d++) {
-        lv_draw_fill(&area_mid, mask, style->body.shadow.color, line_1d_blur[d]);
+        corner_fill(&area_mid, mask, style->body.shadow.color, line_1d_blur[d]);
         area_mid.y1++;
         area_mid.y2++;
     }
@@ -1442,19 +1525,19 @@ static void lv_draw_shadow_full_straight(const lv_area_t * coords, const lv_area
     for(d = 1 /*+ LV_ANTIALIAS*/; d <= swidth /* - LV_ANTIALIAS*/; d++) {
         opa_act = map[d];
 
-        lv_draw_fill(&right_area, mask, style->body.shadow.color, opa_act);
+        corner_fill(&right_area, mask, style->body.shadow.color, opa_act);
         right_area.x1++;
         right_area.x2++;
 
-        lv_draw_fill(&left_area, mask, style->body.shadow.color, opa_act);
+        corner_fill(&left_area, mask, style->body.shadow.color, opa_act);
         left_area.x1--;
         left_area.x2--;
 
-        lv_draw_fill(&top_area, mask, style->body.shadow.color, opa_act);
+        corner_fill(&top_area, mask, style->body.shadow.color, opa_act);
         top_area.y1--;
         top_area.y2--;
 
-        lv_draw_fill(&bottom_area, mask, style->body.shadow.color, opa_act);
+        corner_fill(&bottom_area, mask, style->body.shadow.color, opa_act);
         bottom_area.y1++;
         bottom_area.y2++;
     }
@@ -1480,6 +1563,407 @@ static uint16_t lv_draw_cont_radius_corr(uint16_t r, lv_coord_t w, lv_coord_t h)
     return r;
 }
 
+/**
+ * Draw a pixel of a rounded corner or record it if a corner mask is being created
+ * @param x pixel x coordinate
+ * @param y pixel y coordinate
+ * @param mask draw only on this area
+ * @param color pixel color
+ * @param opa opacity of the pixel
+ */
+static void corner_px(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_color_t color, lv_opa_t opa)
+{
+#if LV_DRAW_CORNER_CACHE_CNT
+    if(corner_rec) {
+        lv_area_t px_area;
+        lv_area_set(&px_area, x, y, x, y);
+        corner_rec_fill(&px_area, mask, color, opa);
+        return;
+    }
+#endif
+
+    lv_draw_px(x, y, mask, color, opa);
+}
+
+/**
+ * Fill an area of a rounded corner or record it if a corner mask is being created
+ * @param coords coordinates of the area to fill
+ * @param mask fill only on this area
+ * @param color fill color
+ * @param opa opacity of the area
+ */
+static void corner_fill(const lv_area_t * coords, const lv_area_t * mask, lv_color_t color, lv_opa_t opa)
+{
+#if LV_DRAW_CORNER_CACHE_CNT
+    if(corner_rec) {
+        corner_rec_fill(coords, mask, color, opa);
+        return;
+    }
+#endif
+
+    lv_draw_fill(coords, mask, color, opa);
+}
+
+#if LV_DRAW_CORNER_CACHE_CNT
+
+/**
+ * Draw the corners of a solid rectangle, border or shadow from a cached mask.
+ * @param type CORNER_TYPE_MAIN/BORDER/SHADOW_FULL/SHADOW_BOTTOM
+ * @param coords the coordinates of the original rectangle
+ * @param mask the rectangle will be drawn only on this area
+ * @param style pointer to a style
+ * @param opa_scale scale down all opacities by the factor
+ * @return true: the corners are drawn; false: they have to be drawn by calculating the circles
+ */
+static bool corner_cache_draw(uint8_t type, const lv_area_t * coords, const lv_area_t * mask,
+                              const lv_style_t * style, lv_opa_t opa_scale)
+{
+    /*A mask is being recorded with the original functions*/
+    if(corner_rec) return false;
+
+    /*The masks are blended to the buffer directly or with `blend_span_cb`*/
+    lv_disp_t * disp = lv_refr_get_disp_refreshing();
+    bool scr_transp  = false;
+#if LV_COLOR_SCREEN_TRANSP
+    scr_transp = disp->driver.screen_transp;
+#endif
+    if(disp->driver.blend_span_cb == NULL &&
+       (disp->driver.set_px_cb != NULL || disp->driver.fill_span_cb != NULL || scr_transp)) {
+        return false;
+    }
+
+    lv_color_t color;
+    lv_opa_t opa;
+    lv_coord_t cwidth = 0;
+    uint8_t part      = 0;
+    if(type == CORNER_TYPE_MAIN) {
+        /*Only a single color can be stored in the masks*/
+        if(style->body.main_color.full != style->body.grad_color.full) return false;
+        color = style->body.main_color;
+        opa   = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
+    } else if(type == CORNER_TYPE_BORDER) {
+        color  = style->body.border.color;
+        opa    = opa_scale == LV_OPA_COVER ? style->body.border.opa
+                                        : (uint16_t)((uint16_t)style->body.border.opa * opa_scale) >> 8;
+        cwidth = style->body.border.width;
+        part   = style->body.border.part;
+    } else {
+        color  = style->body.shadow.color;
+        opa    = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
+        cwidth = style->body.shadow.width;
+    }
+
+    bool aa           = lv_disp_get_antialiasing(disp);
+    lv_coord_t width  = lv_area_get_width(coords);
+    lv_coord_t height = lv_area_get_height(coords);
+    uint16_t radius   = lv_draw_cont_radius_corr(style->body.radius, width, height);
+    if(radius > LV_DRAW_CORNER_CACHE_MAX_R) return false;
+    if(type >= CORNER_TYPE_SHADOW_FULL && radius + cwidth > LV_DRAW_CORNER_CACHE_MAX_R) return false;
+
+    /*The rectangle has to be at least as large as the part of the mask inside it*/
+    lv_coord_t ext;
+    lv_coord_t size = corner_mask_size(type, radius, aa, cwidth, &ext);
+    if(width < size - 2 * ext || height < size - 2 * ext) return false;
+
+    lv_draw_corner_t * corner = corner_cache_get(type, radius, aa, opa, cwidth, part);
+    if(corner->valid == 0) return false;
+
+    corner_blit(corner, coords, mask, color);
+
+    return true;
+}
+
+/**
+ * Get the side length of a corner mask
+ * @param type CORNER_TYPE_MAIN/BORDER/SHADOW_FULL/SHADOW_BOTTOM
+ * @param radius the corrected radius
+ * @param aa true: anti-aliased corners
+ * @param width border or shadow width
+ * @param ext store how far the mask reaches out of the rectangle here
+ * @return side length of the mask
+ */
+static lv_coord_t corner_mask_size(uint8_t type, uint16_t radius, bool aa, lv_coord_t width, lv_coord_t * ext)
+{
+    /*The smallest rectangle whose corners don't touch*/
+    lv_coord_t half = radius + aa + 2;
+    *ext            = 0;
+
+    /*Shadows reach out of the rectangle and anti-aliasing makes their corners larger*/
+    if(type >= CORNER_TYPE_SHADOW_FULL) {
+        half += (SHADOW_BOTTOM_AA_EXTRA_RADIUS + 1) * aa + 1;
+        *ext = width + 1;
+    }
+
+    return 2 * (half + *ext) + 1;
+}
+
+/**
+ * Find a corner mask in the cache or record it in place of the least recently used one
+ * @param type CORNER_TYPE_MAIN/BORDER/SHADOW_FULL/SHADOW_BOTTOM
+ * @param radius the corrected radius
+ * @param aa true: anti-aliased corners
+ * @param opa opacity of the rectangle, border or shadow
+ * @param width border or shadow width from the style
+ * @param part border parts from the style
+ * @return pointer to the corner mask (check its `valid` field)
+ */
+static lv_draw_corner_t * corner_cache_get(uint8_t type, uint16_t radius, bool aa, lv_opa_t opa, lv_coord_t width,
+                                           uint8_t part)
+{
+    lv_draw_corner_t * corner = &corner_cache[0];
+    uint16_t i;
+    for(i = 0; i < LV_DRAW_CORNER_CACHE_CNT; i++) {
+        lv_draw_corner_t * c = &corner_cache[i];
+        if(c->last_use != 0 && c->type == type && c->radius == radius && c->aa == aa && c->opa == opa &&
+           c->width == width && c->part == part) {
+            c->last_use = ++corner_clock;
+            return c;
+        }
+
+        if(c->last_use < corner->last_use) corner = c;
+    }
+
+    corner->last_use = ++corner_clock;
+    corner->type     = type;
+    corner->radius   = radius;
+    corner->aa       = aa;
+    corner->opa      = opa;
+    corner->width    = width;
+    corner->part     = part;
+    corner->size     = corner_mask_size(type, radius, aa, width, &corner->ext);
+    corner->valid    = 1;
+    memset(corner->map, 0, sizeof(corner->map));
+    memset(corner->mixed, 0, sizeof(corner->mixed));
+
+    /*Draw the corners of the smallest possible rectangle to the mask.
+     * Increase the radius because the drawing functions decrease it again with anti-aliasing*/
+    lv_style_t style_rec;
+    lv_style_copy(&style_rec, &lv_style_plain);
+    style_rec.body.radius       = radius + aa;
+    style_rec.body.main_color   = CORNER_REC_COLOR;
+    style_rec.body.grad_color   = CORNER_REC_COLOR;
+    style_rec.body.opa          = opa;
+    style_rec.body.border.color = CORNER_REC_COLOR;
+    style_rec.body.border.width = width;
+    style_rec.body.border.part  = part;
+    style_rec.body.border.opa   = opa;
+    style_rec.body.shadow.color = CORNER_REC_COLOR;
+    style_rec.body.shadow.width = width;
+
+    lv_coord_t size = corner->size;
+    lv_coord_t ext  = corner->ext;
+    lv_area_t area_rec;
+    lv_area_t area_mask;
+    lv_area_set(&area_rec, ext, ext, size - 1 - ext, size - 1 - ext);
+    lv_area_set(&area_mask, 0, 0, size - 1, size - 1);
+
+    corner_rec = corner;
+    switch(type) {
+        case CORNER_TYPE_MAIN: lv_draw_rect_main_corner(&area_rec, &area_mask, &style_rec, LV_OPA_COVER); break;
+        case CORNER_TYPE_BORDER: lv_draw_rect_border_corner(&area_rec, &area_mask, &style_rec, LV_OPA_COVER); break;
+#if LV_USE_SHADOW
+        case CORNER_TYPE_SHADOW_FULL: lv_draw_shadow_full(&area_rec, &area_mask, &style_rec, LV_OPA_COVER); break;
+        case CORNER_TYPE_SHADOW_BOTTOM: lv_draw_shadow_bottom(&area_rec, &area_mask, &style_rec, LV_OPA_COVER); break;
+#endif
+    }
+    corner_rec = NULL;
+
+    if(corner->valid) corner_rows_init(corner);
+
+    /*The middle rows of solid rectangles and borders are drawn by other functions*/
+    if(type <= CORNER_TYPE_BORDER && corner->rows[size >> 1].first != corner->rows[size >> 1].last) {
+        corner->valid = 0;
+    }
+
+    return corner;
+}
+
+/**
+ * Record an area into the corner mask being created
+ * @param coords coordinates of the area
+ * @param mask record only on this area
+ * @param color CORNER_REC_COLOR or it mixed to itself
+ * @param opa opacity of the area
+ */
+static void corner_rec_fill(const lv_area_t * coords, const lv_area_t * mask, lv_color_t color, lv_opa_t opa)
+{
+    if(opa < LV_OPA_MIN) return;
+    if(opa > LV_OPA_MAX) opa = LV_OPA_COVER;
+
+    lv_area_t res_a;
+    if(lv_area_intersect(&res_a, coords, mask) == false) return;
+
+    /*Anti-aliasing mixes the main and gradient colors which gives the color mixed to itself*/
+    lv_color_t color_rec = CORNER_REC_COLOR;
+    uint8_t mixed;
+    if(color.full == color_rec.full) {
+        mixed = 0;
+    } else if(color.full == lv_color_mix(color_rec, color_rec, LV_OPA_COVER).full) {
+        mixed = 1;
+    } else {
+        corner_rec->valid = 0;
+        return;
+    }
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = res_a.y1; y <= res_a.y2; y++) {
+        for(x = res_a.x1; x <= res_a.x2; x++) {
+            uint32_t i = y * corner_rec->size + x;
+            /*The mask can't tell the result of blending a pixel twice*/
+            if(corner_rec->map[i] != LV_OPA_TRANSP) corner_rec->valid = 0;
+            corner_rec->map[i] = opa;
+            corner_rec->mixed[i >> 3] |= mixed << (i & 0x7);
+        }
+    }
+}
+
+/**
+ * Find the parts of the rows of a recorded corner mask which can be filled instead of blended
+ * @param corner pointer to a recorded corner mask
+ */
+static void corner_rows_init(lv_draw_corner_t * corner)
+{
+    lv_coord_t size = corner->size;
+    lv_coord_t mid  = size >> 1;
+    lv_coord_t row;
+    for(row = 0; row < size; row++) {
+        const lv_opa_t * map_p     = &corner->map[row * size];
+        uint32_t mid_i             = row * size + mid;
+        lv_draw_corner_row_t * r_p = &corner->rows[row];
+
+        /*Skip the transparent pixels at the ends*/
+        r_p->first = 0;
+        while(r_p->first < mid && map_p[r_p->first] == LV_OPA_TRANSP) r_p->first++;
+        r_p->last = size;
+        while(r_p->last > mid + 1 && map_p[r_p->last - 1] == LV_OPA_TRANSP) r_p->last--;
+
+        /*Extend the middle column while the pixels are the same*/
+        r_p->run_start = mid;
+        while(r_p->run_start > r_p->first && map_p[r_p->run_start - 1] == map_p[mid] &&
+              CORNER_MIXED(corner, mid_i - (mid - r_p->run_start) - 1) == CORNER_MIXED(corner, mid_i)) {
+            r_p->run_start--;
+        }
+        r_p->run_end = mid + 1;
+        while(r_p->run_end < r_p->last && map_p[r_p->run_end] == map_p[mid] &&
+              CORNER_MIXED(corner, mid_i + (r_p->run_end - mid)) == CORNER_MIXED(corner, mid_i)) {
+            r_p->run_end++;
+        }
+
+        /*Mark the empty rows with `first == last`*/
+        if(r_p->first == r_p->run_start && r_p->run_end == r_p->last && map_p[mid] == LV_OPA_TRANSP) {
+            r_p->first = 0;
+            r_p->last  = 0;
+        }
+    }
+}
+
+/**
+ * Blend a corner mask to the corners of a rectangle
+ * @param corner pointer to a valid corner mask
+ * @param coords the coordinates of the original rectangle
+ * @param mask the rectangle will be drawn only on this area
+ * @param color color of the rectangle, border or shadow
+ */
+static void corner_blit(const lv_draw_corner_t * corner, const lv_area_t * coords, const lv_area_t * mask,
+                        lv_color_t color)
+{
+    lv_coord_t size = corner->size;
+    lv_coord_t mid  = size >> 1;
+    lv_color_t colors[2];
+    colors[0] = color;
+    colors[1] = lv_color_mix(color, color, LV_OPA_COVER);
+
+    /*Area covered by the mask on the screen*/
+    lv_area_t area;
+    lv_area_set(&area, coords->x1 - corner->ext, coords->y1 - corner->ext, coords->x2 + corner->ext,
+                coords->y2 + corner->ext);
+
+    lv_coord_t row;
+    for(row = 0; row < size; row++) {
+        const lv_draw_corner_row_t * r_p = &corner->rows[row];
+        if(r_p->first == r_p->last) continue;
+
+        /*The middle row is the same on the whole height*/
+        lv_area_t row_area;
+        if(row < mid) {
+            row_area.y1 = area.y1 + row;
+            row_area.y2 = row_area.y1;
+        } else if(row > mid) {
+            row_area.y1 = area.y2 - (size - 1 - row);
+            row_area.y2 = row_area.y1;
+        } else {
+            row_area.y1 = area.y1 + mid;
+            row_area.y2 = area.y2 - mid;
+        }
+        if(row_area.y1 < mask->y1) row_area.y1 = mask->y1;
+        if(row_area.y2 > mask->y2) row_area.y2 = mask->y2;
+        if(row_area.y1 > row_area.y2) continue;
+
+        uint32_t map_i = row * size;
+        lv_coord_t y;
+        for(y = row_area.y1; y <= row_area.y2; y++) {
+            corner_blit_span(corner, map_i + r_p->first, area.x1 + r_p->first, y, r_p->run_start - r_p->first, mask,
+                             colors);
+            corner_blit_span(corner, map_i + r_p->run_end, area.x2 - (size - 1 - r_p->run_end), y,
+                             r_p->last - r_p->run_end, mask, colors);
+        }
+
+        /*The middle column is the same on the whole width*/
+        if(corner->map[map_i + mid] != LV_OPA_TRANSP) {
+            row_area.x1 = area.x1 + r_p->run_start;
+            row_area.x2 = area.x2 - (size - r_p->run_end);
+            lv_draw_fill(&row_area, mask, colors[CORNER_MIXED(corner, map_i + mid)], corner->map[map_i + mid]);
+        }
+    }
+}
+
+/**
+ * Blend a part of a row of a corner mask to the display buffer
+ * @param corner pointer to a valid corner mask
+ * @param map_i index of the first pixel in the mask
+ * @param x x coordinate of the first pixel
+ * @param y y coordinate of the row
+ * @param len number of pixels
+ * @param mask blend only on this area
+ * @param colors the color and the color mixed to itself
+ */
+static void corner_blit_span(const lv_draw_corner_t * corner, uint32_t map_i, lv_coord_t x, lv_coord_t y,
+                             lv_coord_t len, const lv_area_t * mask, const lv_color_t * colors)
+{
+    static LV_REFR_TLS LV_ATTRIBUTE_MEM_ALIGN lv_color_t color_buf[CORNER_MASK_SIZE_MAX];
+
+    lv_coord_t x_end = x + len - 1;
+    if(x < mask->x1) {
+        map_i += mask->x1 - x;
+        x = mask->x1;
+    }
+    if(x_end > mask->x2) x_end = mask->x2;
+    if(x > x_end) return;
+
+    len = x_end - x + 1;
+    lv_coord_t i;
+    for(i = 0; i < len; i++) color_buf[i] = colors[CORNER_MIXED(corner, map_i + i)];
+    const lv_opa_t * alpha = &corner->map[map_i];
+
+    lv_disp_t * disp     = lv_refr_get_disp_refreshing();
+    lv_disp_buf_t * vdb  = lv_disp_get_buf(disp);
+    lv_coord_t vdb_width = lv_area_get_width(&vdb->area);
+
+    /*Make the coordinates relative to VDB*/
+    x -= vdb->area.x1;
+    y -= vdb->area.y1;
+
+    if(disp->driver.blend_span_cb) {
+        disp->driver.blend_span_cb(&disp->driver, (uint8_t *)vdb->buf_act, vdb_width, x, y, len, color_buf, alpha);
+    } else {
+        lv_color_t * vdb_buf = vdb->buf_act;
+        lv_blend_map_alpha(&vdb_buf[y * vdb_width + x], color_buf, alpha, len);
+    }
+}
+
+#endif /*LV_DRAW_CORNER_CACHE_CNT*/
+
 #if LV_ANTIALIAS
 
 /**
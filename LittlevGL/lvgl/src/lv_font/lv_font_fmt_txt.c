@@ -11,6 +11,7 @@
 #include "../lv_misc/lv_types.h"
 #include "../lv_misc/lv_log.h"
 #include "../lv_misc/lv_utils.h"
+#include "../lv_core/lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -32,6 +33,10 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
 /**********************
  *  STATIC VARIABLES
  **********************/
+/*Cache the last letter and its glyph id. Per thread because the bands are rendered in parallel*/
+static LV_REFR_TLS const lv_font_fmt_txt_dsc_t * last_fdsc;
+static LV_REFR_TLS uint32_t last_letter;
+static LV_REFR_TLS uint32_t last_glyph_id;
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -114,7 +119,7 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
 
     /*Check the chacge first*/
-    if(letter == fdsc->last_letter) return fdsc->last_glyph_id;
+    if(fdsc == last_fdsc && letter == last_letter) return last_glyph_id;
 
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
@@ -151,13 +156,15 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
         }
 
         /*Update the cache*/
-        fdsc->last_letter = letter;
-        fdsc->last_glyph_id = glyph_id;
+        last_fdsc = fdsc;
+        last_letter = letter;
+        last_glyph_id = glyph_id;
         return glyph_id;
     }
 
-    fdsc->last_letter = letter;
-    fdsc->last_glyph_id = 0;
+    last_fdsc = fdsc;
+    last_letter = letter;
+    last_glyph_id = 0;
     return 0;
 
 }
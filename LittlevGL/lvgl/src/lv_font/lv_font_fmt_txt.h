@@ -190,7 +190,8 @@ typedef struct {
      */
     uint16_t bitmap_format  :2;
 
-    /*Cache the last letter and is glyph id*/
+    /*Not used: the last letter and its glyph id are cached per rendering thread in lv_font_fmt_txt.c.
+     *Kept for the fonts which initialize them*/
     uint32_t last_letter;
     uint32_t last_glyph_id;
 
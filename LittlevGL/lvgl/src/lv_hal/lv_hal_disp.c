@@ -80,7 +80,17 @@ void lv_disp_drv_init(lv_disp_drv_t * driver)
     driver->user_data = NULL;
 #endif
 
-    driver->set_px_cb = NULL;
+    driver->set_px_cb     = NULL;
+    driver->fill_span_cb  = NULL;
+    driver->blend_span_cb = NULL;
+    driver->wait_cb        = NULL;
+    driver->flush_ready_cb = NULL;
+    driver->copy_cb        = NULL;
+    driver->vsync_cb       = NULL;
+    driver->diff_buf       = NULL;
+
+    driver->refr_period = LV_DISP_DEF_REFR_PERIOD;
+    driver->area_cost   = LV_REFR_AREA_COST;
 }
 
 /**
@@ -123,6 +133,7 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
     }
 
     memcpy(&disp->driver, driver, sizeof(lv_disp_drv_t));
+    disp->refr_task = NULL; /*Created later, but areas are invalidated before (see `lv_inv_area`)*/
     memset(&disp->inv_area_joined, 0, sizeof(disp->inv_area_joined));
     memset(&disp->inv_areas, 0, sizeof(disp->inv_areas));
     lv_ll_init(&disp->scr_ll, sizeof(lv_obj_t));
@@ -134,6 +145,21 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
                                         new display*/
 
     disp->inv_p = 0;
+    disp->inv_merge_cnt = 0;
+#if LV_REFR_MOVE_CNT
+    disp->move_cnt = 0;
+    disp->copied_cnt = 0;
+#endif
+    disp->draw_px       = 0;
+    disp->cull_px       = 0;
+
+    disp->inv_time       = 0;
+    disp->inv_timed      = 0;
+    disp->frame_late_cnt = 0;
+    disp->frame_drop_cnt = 0;
+    disp->refr_div       = 1;
+    disp->diff_valid     = 0;
+    disp->vsync_off      = 0;
 
     disp->act_scr   = lv_obj_create(NULL, NULL); /*Create a default screen on the display*/
     disp->top_layer = lv_obj_create(NULL, NULL); /*Create top layer on the display*/
@@ -146,7 +172,7 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
     disp_def = disp_def_tmp; /*Revert the default display*/
 
     /*Create a refresh task*/
-    disp->refr_task = lv_task_create(lv_disp_refr_task, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, disp);
+    disp->refr_task = lv_task_create(lv_disp_refr_task, disp->driver.refr_period, LV_TASK_PRIO_MID, disp);
     lv_mem_assert(disp->refr_task);
     if(disp->refr_task == NULL) return NULL;
 
@@ -163,6 +189,11 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
 void lv_disp_drv_update(lv_disp_t * disp, lv_disp_drv_t * new_drv)
 {
     memcpy(&disp->driver, new_drv, sizeof(lv_disp_drv_t));
+    disp->diff_valid = 0; /*The resolution or `diff_buf` may be changed*/
+    disp->vsync_off  = 0; /*Try the new `vsync_cb`*/
+
+    /*Apply a new refresh period*/
+    if(disp->refr_task) lv_task_set_period(disp->refr_task, disp->driver.refr_period * disp->refr_div);
 
     lv_obj_t * scr;
     LV_LL_READ(disp->scr_ll, scr)
@@ -267,7 +298,10 @@ bool lv_disp_get_antialiasing(lv_disp_t * disp)
  */
 LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_ready(lv_disp_drv_t * disp_drv)
 {
-    disp_drv->buffer->flushing = 0;
+    if(disp_drv->flush_ready_cb) disp_drv->flush_ready_cb(disp_drv);
+
+    /*Release: the flushed pixels are visible to the rendering thread when it sees the flag cleared*/
+    __atomic_store_n(&disp_drv->buffer->flushing, 0, __ATOMIC_RELEASE);
 
     /*If the screen is transparent initialize it when the flushing is ready*/
 #if LV_COLOR_SCREEN_TRANSP
@@ -277,6 +311,17 @@ LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_ready(lv_disp_drv_t * disp_drv)
 #endif
 }
 
+/**
+ * Tell if the area being flushed is the last one of the frame.
+ * Drivers of displays on a slow bus can queue the areas and send them together on the last one.
+ * @param disp_drv pointer to display driver in `flush_cb` where this function is called
+ * @return true: the last area of the frame is being flushed
+ */
+LV_ATTRIBUTE_FLUSH_READY bool lv_disp_flush_is_last(lv_disp_drv_t * disp_drv)
+{
+    return disp_drv->buffer->flushing_last != 0;
+}
+
 /**
  * Get the next display.
  * @param disp pointer to the current display. NULL to initialize.
@@ -322,6 +367,43 @@ void lv_disp_pop_from_inv_buf(lv_disp_t * disp, uint16_t num)
         disp->inv_p -= num;
 }
 
+/**
+ * Get how many times invalidated areas were merged because the buffer was full.
+ * Each merge avoids refreshing the whole screen.
+ * @param disp pointer to a display
+ * @return number of merges since the display was registered
+ */
+uint32_t lv_disp_get_inv_merge_cnt(lv_disp_t * disp)
+{
+    return disp->inv_merge_cnt;
+}
+
+/**
+ * Get the overdraw of the last refresh, e.g. in `monitor_cb`
+ * @param disp pointer to a display
+ * @param draw_px store the number of pixels passed to the objects to draw here.
+ *                Compared to the refreshed pixels it tells how many times a pixel is drawn.
+ * @param cull_px store the number of pixels not drawn because opaque objects hide them here
+ */
+void lv_disp_get_overdraw(lv_disp_t * disp, uint32_t * draw_px, uint32_t * cull_px)
+{
+    *draw_px = disp->draw_px;
+    *cull_px = disp->cull_px;
+}
+
+/**
+ * Get the frame pacing statistics, e.g. in `monitor_cb`
+ * @param disp pointer to a display
+ * @param late_cnt store the number of frames started more than a period after the first
+ *                 invalidation since the previous frame here
+ * @param drop_cnt store the number of periods without a frame while an area was invalid here
+ */
+void lv_disp_get_frame_stats(lv_disp_t * disp, uint32_t * late_cnt, uint32_t * drop_cnt)
+{
+    *late_cnt = disp->frame_late_cnt;
+    *drop_cnt = disp->frame_drop_cnt;
+}
+
 /**
  * Check the driver configuration if it's double buffered (both `buf1` and `buf2` are set)
  * @param disp pointer to to display to check
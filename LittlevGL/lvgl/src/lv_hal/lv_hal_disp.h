@@ -30,6 +30,10 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /*Buffer size for invalid areas */
 #endif
 
+#ifndef LV_REFR_MOVE_CNT
+#define LV_REFR_MOVE_CNT 0 /*Number of moved objects copied on the display instead of redrawn*/
+#endif
+
 #ifndef LV_ATTRIBUTE_FLUSH_READY
 #define LV_ATTRIBUTE_FLUSH_READY
 #endif
@@ -53,7 +57,10 @@ typedef struct
     void * buf_act;
     uint32_t size; /*In pixel count*/
     lv_area_t area;
-    volatile uint32_t flushing : 1;
+    int flushing; /*Not a bit field, it may be cleared by an other thread. Accessed atomically*/
+    int flushing_last; /*1: the part being flushed is the last one of the frame*/
+    uint32_t last_area : 1; /*1: the last area of the frame is being rendered*/
+    uint32_t last_part : 1; /*1: the last part of the current area is being rendered*/
 } lv_disp_buf_t;
 
 /**
@@ -74,6 +81,15 @@ typedef struct _disp_drv_t
 #endif
     uint32_t rotated : 1; /**< 1: turn the display by 90 degree. @warning Does not update coordinates for you!*/
 
+    /** Period of the refresh [ms], `LV_DISP_DEF_REFR_PERIOD` by default.
+     * Lengthened to a multiple of it while the frames take longer to render.*/
+    uint16_t refr_period;
+
+    /** Pixels worth refreshing to save flushing one more area, e.g. the cost of setting the
+     * window of a display on a slow bus. Nearby areas are joined if it adds fewer pixels.
+     * `LV_REFR_AREA_COST` by default*/
+    uint32_t area_cost;
+
 #if LV_COLOR_SCREEN_TRANSP
     /**Handle if the the screen doesn't have a solid (opa == LV_OPA_COVER) background.
      * Use only if required because it's slower.*/
@@ -94,10 +110,43 @@ typedef struct _disp_drv_t
     void (*set_px_cb)(struct _disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
                       lv_color_t color, lv_opa_t opa);
 
+    /** OPTIONAL: Fill a horizontal span of a buffer with special requirements, like `set_px_cb` but
+     * for `len` pixels from `x` at once. Set `blend_span_cb` too, together they replace `set_px_cb`*/
+    void (*fill_span_cb)(struct _disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
+                         lv_coord_t len, lv_color_t color, lv_opa_t opa);
+
+    /** OPTIONAL: Blend `len` pixels to a horizontal span of a buffer with special requirements.
+     * `alpha` is the opacity of each pixel, LV_OPA_TRANSP pixels have to be skipped*/
+    void (*blend_span_cb)(struct _disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
+                          lv_coord_t len, const lv_color_t * colors, const lv_opa_t * alpha);
+
     /** OPTIONAL: Called after every refresh cycle to tell the rendering and flushing time + the
      * number of flushed pixels */
     void (*monitor_cb)(struct _disp_drv_t * disp_drv, uint32_t time, uint32_t px);
 
+    /** OPTIONAL: Called repeatedly while LittlevGL waits for the flushing to be ready.
+     * Can block until `lv_disp_flush_ready()` is called, instead of busy waiting.
+     * Useful when an other thread (or DMA) flushes concurrently with the rendering*/
+    void (*wait_cb)(struct _disp_drv_t * disp_drv);
+
+    /** OPTIONAL: Called by `lv_disp_flush_ready()` in the thread which finished the flushing.
+     * E.g. to measure the flushing when it's done concurrently with the rendering*/
+    void (*flush_ready_cb)(struct _disp_drv_t * disp_drv);
+
+    /** OPTIONAL: Copy an area of the display to an other place. The areas can overlap.
+     * Used to move objects without redrawing them (see `LV_REFR_MOVE_CNT`).
+     * Return `false` if not possible, the areas are redrawn then. Not used with true double buffering.*/
+    bool (*copy_cb)(struct _disp_drv_t * disp_drv, const lv_area_t * dest_area, const lv_area_t * src_area);
+
+    /** OPTIONAL: Wait for the vertical sync of the display, called before a frame is rendered
+     * to align the refreshes with the scanout. `refr_period` should be a bit shorter than a scanout.
+     * Return `false` if not supported, it won't be called again until `lv_disp_drv_update`.*/
+    bool (*vsync_cb)(struct _disp_drv_t * disp_drv);
+
+    /** OPTIONAL: A screen sized buffer to hold the last flushed frame. The rendered areas are
+     * compared to it and only their changed parts are flushed. Not used with true double buffering*/
+    lv_color_t * diff_buf;
+
 #if LV_USE_GPU
     /** OPTIONAL: Blend two memories using opacity (GPU only)*/
     void (*gpu_blend_cb)(struct _disp_drv_t * disp_drv, lv_color_t * dest, const lv_color_t * src, uint32_t length,
@@ -120,6 +169,18 @@ typedef struct _disp_drv_t
 
 struct _lv_obj_t;
 
+#if LV_REFR_MOVE_CNT
+/**
+ * An object moved since the last refresh
+ */
+typedef struct
+{
+    struct _lv_obj_t * obj;
+    lv_area_t src;  /**< Coordinates of the object on the display*/
+    lv_area_t dest; /**< Coordinates of the object after the moves*/
+} lv_disp_move_t;
+#endif
+
 /**
  * Display structure.
  * ::lv_disp_drv_t is the first member of the structure.
@@ -142,6 +203,28 @@ typedef struct _disp_t
     lv_area_t inv_areas[LV_INV_BUF_SIZE];
     uint8_t inv_area_joined[LV_INV_BUF_SIZE];
     uint32_t inv_p : 10;
+    uint32_t inv_merge_cnt; /**< Areas merged because the buffer was full, see `lv_inv_area`*/
+
+#if LV_REFR_MOVE_CNT
+    /** Moved objects to copy on the display, see `lv_refr_move`*/
+    lv_disp_move_t moves[LV_REFR_MOVE_CNT];
+    uint8_t move_cnt;
+    lv_area_t copied[LV_REFR_MOVE_CNT]; /**< Copied areas to sync to the other buffer of true double buffering*/
+    uint8_t copied_cnt;
+#endif
+
+    /** Frame pacing*/
+    uint32_t inv_time;       /**< Time of the first invalidation since the last refresh*/
+    uint32_t frame_late_cnt; /**< Frames started more than a period after the first invalidation*/
+    uint32_t frame_drop_cnt; /**< Periods without a frame while an area was invalid*/
+    uint8_t refr_div;        /**< Refresh in every `refr_div`th period, increased when frames overrun*/
+    uint8_t inv_timed : 1;   /**< 1: `inv_time` is set*/
+    uint8_t diff_valid : 1;  /**< 1: `diff_buf` of the driver holds the last flushed frame*/
+    uint8_t vsync_off : 1;   /**< 1: `vsync_cb` of the driver returned `false`, don't call it*/
+
+    /** Overdraw of the last refresh*/
+    uint32_t draw_px; /**< Pixels passed to the objects to draw, overlapping objects counted again*/
+    uint32_t cull_px; /**< Pixels not drawn because opaque objects hide them*/
 
     /*Miscellaneous data*/
     uint32_t last_activity_time; /**< Last time there was activity on this display */
@@ -238,6 +321,14 @@ bool lv_disp_get_antialiasing(lv_disp_t * disp);
  */
 LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_ready(lv_disp_drv_t * disp_drv);
 
+/**
+ * Tell if the area being flushed is the last one of the frame.
+ * Drivers of displays on a slow bus can queue the areas and send them together on the last one.
+ * @param disp_drv pointer to display driver in `flush_cb` where this function is called
+ * @return true: the last area of the frame is being flushed
+ */
+LV_ATTRIBUTE_FLUSH_READY bool lv_disp_flush_is_last(lv_disp_drv_t * disp_drv);
+
 //! @endcond
 
 /**
@@ -266,6 +357,32 @@ uint16_t lv_disp_get_inv_buf_size(lv_disp_t * disp);
  */
 void lv_disp_pop_from_inv_buf(lv_disp_t * disp, uint16_t num);
 
+/**
+ * Get how many times invalidated areas were merged because the buffer was full.
+ * Each merge avoids refreshing the whole screen.
+ * @param disp pointer to a display
+ * @return number of merges since the display was registered
+ */
+uint32_t lv_disp_get_inv_merge_cnt(lv_disp_t * disp);
+
+/**
+ * Get the overdraw of the last refresh, e.g. in `monitor_cb`
+ * @param disp pointer to a display
+ * @param draw_px store the number of pixels passed to the objects to draw here.
+ *                Compared to the refreshed pixels it tells how many times a pixel is drawn.
+ * @param cull_px store the number of pixels not drawn because opaque objects hide them here
+ */
+void lv_disp_get_overdraw(lv_disp_t * disp, uint32_t * draw_px, uint32_t * cull_px);
+
+/**
+ * Get the frame pacing statistics, e.g. in `monitor_cb`
+ * @param disp pointer to a display
+ * @param late_cnt store the number of frames started more than a period after the first
+ *                 invalidation since the previous frame here
+ * @param drop_cnt store the number of periods without a frame while an area was invalid here
+ */
+void lv_disp_get_frame_stats(lv_disp_t * disp, uint32_t * late_cnt, uint32_t * drop_cnt);
+
 /**
  * Check the driver configuration if it's double buffered (both `buf1` and `buf2` are set)
  * @param disp pointer to to display to check
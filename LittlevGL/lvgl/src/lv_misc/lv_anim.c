@@ -35,12 +35,14 @@
  **********************/
 static void anim_task(lv_task_t * param);
 static bool anim_ready_handler(lv_anim_t * a);
+static void anim_task_resume(void);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t last_task_run;
 static bool anim_list_changed;
+static lv_task_t * anim_task_p;
 
 /**********************
  *      MACROS
@@ -57,7 +59,9 @@ void lv_anim_core_init(void)
 {
     lv_ll_init(&LV_GC_ROOT(_lv_anim_ll), sizeof(lv_anim_t));
     last_task_run = lv_tick_get();
-    lv_task_create(anim_task, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, NULL);
+
+    /*The task is turned off while there are no animations (see `anim_task`)*/
+    anim_task_p = lv_task_create(anim_task, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_OFF, NULL);
 }
 
 /**
@@ -96,6 +100,8 @@ void lv_anim_create(lv_anim_t * a)
     a->playback_now = 0;
     memcpy(new_anim, a, sizeof(lv_anim_t));
 
+    anim_task_resume();
+
     /*Set the start value*/
     if(new_anim->exec_cb) new_anim->exec_cb(new_anim->var, new_anim->start);
 
@@ -423,6 +429,11 @@ static void anim_task(lv_task_t * param)
     }
 
     last_task_run = lv_tick_get();
+
+    /*Nothing to animate: don't wake up until a new animation is created*/
+    if(lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) == NULL) {
+        lv_task_set_prio(anim_task_p, LV_TASK_PRIO_OFF);
+    }
 }
 
 /**
@@ -470,4 +481,17 @@ static bool anim_ready_handler(lv_anim_t * a)
 
     return anim_list_changed;
 }
+
+/**
+ * Turn on the animation task if it was turned off because there were no animations
+ */
+static void anim_task_resume(void)
+{
+    if(anim_task_p == NULL || anim_task_p->prio != LV_TASK_PRIO_OFF) return;
+
+    /*Don't count the time while the task was off as animation time*/
+    last_task_run = lv_tick_get();
+    lv_task_set_prio(anim_task_p, LV_TASK_PRIO_MID);
+    lv_task_reset(anim_task_p);
+}
 #endif
@@ -340,6 +340,34 @@ uint8_t lv_task_get_idle(void)
     return idle_last;
 }
 
+/**
+ * Get the time remaining until the next lv_task has to run.
+ * Tasks with `LV_TASK_PRIO_OFF` priority are not considered.
+ * Can be used to sleep between two `lv_task_handler` calls.
+ * @return time in milliseconds (0: a task is ready now),
+ *         `LV_NO_TASK_READY` if there are no running tasks
+ */
+uint32_t lv_task_get_time_till_next(void)
+{
+    if(lv_task_run == false) return LV_NO_TASK_READY;
+
+    uint32_t time_till_next = LV_NO_TASK_READY;
+    lv_task_t * task;
+    LV_LL_READ(LV_GC_ROOT(_lv_task_ll), task)
+    {
+        /*The tasks are ordered by priority so only turned off tasks follow*/
+        if(task->prio == LV_TASK_PRIO_OFF) break;
+
+        uint32_t elp = lv_tick_elaps(task->last_run);
+        if(elp >= task->period) return 0;
+
+        uint32_t remaining = task->period - elp;
+        if(remaining < time_till_next) time_till_next = remaining;
+    }
+
+    return time_till_next;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
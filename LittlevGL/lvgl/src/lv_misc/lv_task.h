@@ -31,6 +31,9 @@ extern "C" {
 #ifndef LV_ATTRIBUTE_TASK_HANDLER
 #define LV_ATTRIBUTE_TASK_HANDLER
 #endif
+
+/*Returned by `lv_task_get_time_till_next` if no task will ever be ready*/
+#define LV_NO_TASK_READY 0xFFFFFFFF
 /**********************
  *      TYPEDEFS
  **********************/
@@ -166,6 +169,15 @@ void lv_task_enable(bool en);
  */
 uint8_t lv_task_get_idle(void);
 
+/**
+ * Get the time remaining until the next lv_task has to run.
+ * Tasks with `LV_TASK_PRIO_OFF` priority are not considered.
+ * Can be used to sleep between two `lv_task_handler` calls.
+ * @return time in milliseconds (0: a task is ready now),
+ *         `LV_NO_TASK_READY` if there are no running tasks
+ */
+uint32_t lv_task_get_time_till_next(void);
+
 /**********************
  *      MACROS
  **********************/
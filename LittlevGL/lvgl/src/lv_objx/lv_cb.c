@@ -10,6 +10,7 @@
 #if LV_USE_CB != 0
 
 #include "../lv_core/lv_group.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_themes/lv_theme.h"
 
 /*********************
@@ -259,6 +260,9 @@ static bool lv_bullet_design(lv_obj_t * bullet, const lv_area_t * mask, lv_desig
         return ancestor_bullet_design(bullet, mask, mode);
     } else if(mode == LV_DESIGN_DRAW_MAIN) {
 #if LV_USE_GROUP
+        /*The style change trick below must not be seen by other rendering threads*/
+        lv_refr_lock();
+
         /* If the check box is the active in a group and
          * the background is not visible (transparent)
          * then activate the style of the bullet*/
@@ -278,6 +282,8 @@ static bool lv_bullet_design(lv_obj_t * bullet, const lv_area_t * mask, lv_desig
 
 #if LV_USE_GROUP
         bullet->style_p = style_ori; /*Revert the style*/
+
+        lv_refr_unlock();
 #endif
     } else if(mode == LV_DESIGN_DRAW_POST) {
         ancestor_bullet_design(bullet, mask, mode);
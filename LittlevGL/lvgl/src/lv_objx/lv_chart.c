@@ -1276,13 +1276,13 @@ static void lv_chart_inv_lines(lv_obj_t * chart, uint16_t i)
         if(i < ext->point_cnt - 1) {
             coords.x1 = ((w * i) / (ext->point_cnt - 1)) + x_ofs - ext->series.width;
             coords.x2 = ((w * (i + 1)) / (ext->point_cnt - 1)) + x_ofs + ext->series.width;
-            lv_inv_area(lv_obj_get_disp(chart), &coords);
+            lv_obj_invalidate_area(chart, &coords);
         }
 
         if(i > 0) {
             coords.x1 = ((w * (i - 1)) / (ext->point_cnt - 1)) + x_ofs - ext->series.width;
             coords.x2 = ((w * i) / (ext->point_cnt - 1)) + x_ofs + ext->series.width;
-            lv_inv_area(lv_obj_get_disp(chart), &coords);
+            lv_obj_invalidate_area(chart, &coords);
         }
     }
 }
@@ -1305,7 +1305,7 @@ static void lv_chart_inv_points(lv_obj_t * chart, uint16_t i)
     cir_a.x2 = cir_a.x1 + ext->series.width;
     cir_a.x1 -= ext->series.width;
 
-    lv_inv_area(lv_obj_get_disp(chart), &cir_a);
+    lv_obj_invalidate_area(chart, &cir_a);
 }
 
 /**
@@ -1331,7 +1331,7 @@ static void lv_chart_inv_cols(lv_obj_t * chart, uint16_t i)
     col_a.x1 = x_act;
     col_a.x2 = col_a.x1 + col_w;
 
-    lv_inv_area(lv_obj_get_disp(chart), &col_a);
+    lv_obj_invalidate_area(chart, &col_a);
 }
 
 #endif
@@ -266,31 +266,20 @@ static bool lv_gauge_design(lv_obj_t * gauge, const lv_area_t * mask, lv_design_
     /*Draw the object*/
     else if(mode == LV_DESIGN_DRAW_MAIN) {
 
-        /* Store the real pointer because of 'lv_group'
-         * If the object is in focus 'lv_obj_get_style()' will give a pointer to tmp style
-         * and to the real object style. It is important because of style change tricks below*/
-        const lv_style_t * style_ori_p = gauge->style_p;
-        const lv_style_t * style       = lv_obj_get_style(gauge);
-        lv_gauge_ext_t * ext           = lv_obj_get_ext_attr(gauge);
+        const lv_style_t * style = lv_obj_get_style(gauge);
+        lv_gauge_ext_t * ext     = lv_obj_get_ext_attr(gauge);
 
         lv_gauge_draw_scale(gauge, mask);
 
         /*Draw the ancestor line meter with max value to show the rainbow like line colors*/
-        uint16_t line_cnt_tmp = ext->lmeter.line_cnt;
         ancestor_design(gauge, mask, mode); /*To draw lines*/
 
-        /*Temporally modify the line meter to draw longer lines where labels are*/
+        /*Draw longer lines where labels are with a local style*/
         lv_style_t style_tmp;
         lv_style_copy(&style_tmp, style);
-        ext->lmeter.line_cnt         = ext->label_count;                 /*Only to labels*/
         style_tmp.body.padding.left  = style_tmp.body.padding.left * 2;  /*Longer lines*/
         style_tmp.body.padding.right = style_tmp.body.padding.right * 2; /*Longer lines*/
-        gauge->style_p               = &style_tmp;
-
-        ancestor_design(gauge, mask, mode); /*To draw lines*/
-
-        ext->lmeter.line_cnt = line_cnt_tmp; /*Restore the parameters*/
-        gauge->style_p       = style_ori_p;  /*Restore the ORIGINAL style pointer*/
+        lv_lmeter_draw_lines(gauge, mask, &style_tmp, ext->label_count);
 
         lv_gauge_draw_needle(gauge, mask);
 
@@ -11,6 +11,7 @@
 
 #include "../lv_core/lv_obj.h"
 #include "../lv_core/lv_group.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_color.h"
 #include "../lv_misc/lv_math.h"
 
@@ -861,13 +862,27 @@ static bool lv_label_design(lv_obj_t * label, const lv_area_t * mask, lv_design_
             }
         }
 
-        lv_draw_label_hint_t * hint = &ext->hint;
+        /*Work on a copy of the hint because the other rendering threads might draw the same label*/
+        lv_draw_label_hint_t hint_tmp;
+        lv_draw_label_hint_t * hint = &hint_tmp;
         if(ext->long_mode == LV_LABEL_LONG_SROLL_CIRC || lv_obj_get_height(label) < LV_LABEL_HINT_HEIGHT_LIMIT)
             hint = NULL;
 
+        if(hint) {
+            lv_refr_lock();
+            hint_tmp = ext->hint;
+            lv_refr_unlock();
+        }
+
         lv_draw_label(&coords, mask, style, opa_scale, ext->text, flag, &ext->offset,
                       lv_label_get_text_sel_start(label), lv_label_get_text_sel_end(label), hint);
 
+        if(hint) {
+            lv_refr_lock();
+            ext->hint = hint_tmp;
+            lv_refr_unlock();
+        }
+
         if(ext->long_mode == LV_LABEL_LONG_SROLL_CIRC) {
             lv_point_t size;
             lv_txt_get_size(&size, ext->text, style->text.font, style->text.letter_space, style->text.line_space,
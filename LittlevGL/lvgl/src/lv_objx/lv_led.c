@@ -189,11 +189,6 @@ static bool lv_led_design(lv_obj_t * led, const lv_area_t * mask, lv_design_mode
         lv_led_ext_t * ext       = lv_obj_get_ext_attr(led);
         const lv_style_t * style = lv_obj_get_style(led);
 
-        /* Store the real pointer because of 'lv_group'
-         * If the object is in focus 'lv_obj_get_style()' will give a pointer to tmp style
-         * and to the real object style. It is important because of style change tricks below*/
-        const lv_style_t * style_ori_p = led->style_p;
-
         /*Create a temporal style*/
         lv_style_t leds_tmp;
         memcpy(&leds_tmp, style, sizeof(leds_tmp));
@@ -209,9 +204,9 @@ static bool lv_led_design(lv_obj_t * led, const lv_area_t * mask, lv_design_mode
         leds_tmp.body.shadow.width =
             ((bright_tmp - LV_LED_BRIGHT_OFF) * style->body.shadow.width) / (LV_LED_BRIGHT_ON - LV_LED_BRIGHT_OFF);
 
-        led->style_p = &leds_tmp;
-        ancestor_design_f(led, mask, mode);
-        led->style_p = style_ori_p; /*Restore the ORIGINAL style pointer*/
+        /*Draw with the temporal style directly instead of setting it to the object
+         * because the other rendering threads might draw the same LED at the same time*/
+        lv_draw_rect(&led->coords, mask, &leds_tmp, lv_obj_get_opa_scale(led));
     }
     return true;
 }
@@ -227,6 +227,85 @@ uint16_t lv_lmeter_get_scale_angle(const lv_obj_t * lmeter)
     return ext->scale_angle;
 }
 
+/*=====================
+ * Other functions
+ *====================*/
+
+/**
+ * Draw the lines of a line meter with a given style and line count.
+ * Used by the line meter and by objects which draw more lines over it (e.g. gauge)
+ * without modifying the object while it's being drawn.
+ * @param lmeter pointer to a line meter object
+ * @param mask the lines will be drawn only in this area
+ * @param style style to draw with (`body.padding.left` is the line length)
+ * @param line_cnt number of lines
+ */
+void lv_lmeter_draw_lines(lv_obj_t * lmeter, const lv_area_t * mask, const lv_style_t * style, uint8_t line_cnt)
+{
+    lv_lmeter_ext_t * ext = lv_obj_get_ext_attr(lmeter);
+    lv_opa_t opa_scale    = lv_obj_get_opa_scale(lmeter);
+    lv_style_t style_tmp;
+    lv_style_copy(&style_tmp, style);
+
+#if LV_USE_GROUP
+    lv_group_t * g = lv_obj_get_group(lmeter);
+    if(lv_group_get_focused(g) == lmeter) {
+        style_tmp.line.width += 1;
+    }
+#endif
+
+    lv_coord_t r_out = lv_obj_get_width(lmeter) / 2;
+    lv_coord_t r_in  = r_out - style->body.padding.left;
+    if(r_in < 1) r_in = 1;
+
+    lv_coord_t x_ofs  = lv_obj_get_width(lmeter) / 2 + lmeter->coords.x1;
+    lv_coord_t y_ofs  = lv_obj_get_height(lmeter) / 2 + lmeter->coords.y1;
+    int16_t angle_ofs = 90 + (360 - ext->scale_angle) / 2;
+    int16_t level =
+        (int32_t)((int32_t)(ext->cur_value - ext->min_value) * line_cnt) / (ext->max_value - ext->min_value);
+    uint8_t i;
+
+    style_tmp.line.color = style->body.main_color;
+
+    /*Calculate every coordinate in a bigger size to make rounding later*/
+    r_out = r_out << LV_LMETER_LINE_UPSCALE;
+    r_in  = r_in << LV_LMETER_LINE_UPSCALE;
+
+    for(i = 0; i < line_cnt; i++) {
+        /*Calculate the position a scale label*/
+        int16_t angle = (i * ext->scale_angle) / (line_cnt - 1) + angle_ofs;
+
+        lv_coord_t y_out = (int32_t)((int32_t)lv_trigo_sin(angle) * r_out) >> LV_TRIGO_SHIFT;
+        lv_coord_t x_out = (int32_t)((int32_t)lv_trigo_sin(angle + 90) * r_out) >> LV_TRIGO_SHIFT;
+        lv_coord_t y_in  = (int32_t)((int32_t)lv_trigo_sin(angle) * r_in) >> LV_TRIGO_SHIFT;
+        lv_coord_t x_in  = (int32_t)((int32_t)lv_trigo_sin(angle + 90) * r_in) >> LV_TRIGO_SHIFT;
+
+        /*Rounding*/
+        x_out = lv_lmeter_coord_round(x_out);
+        x_in  = lv_lmeter_coord_round(x_in);
+        y_out = lv_lmeter_coord_round(y_out);
+        y_in  = lv_lmeter_coord_round(y_in);
+
+        lv_point_t p1;
+        lv_point_t p2;
+
+        p2.x = x_in + x_ofs;
+        p2.y = y_in + y_ofs;
+
+        p1.x = x_out + x_ofs;
+        p1.y = y_out + y_ofs;
+
+        if(i >= level)
+            style_tmp.line.color = style->line.color;
+        else {
+            style_tmp.line.color =
+                lv_color_mix(style->body.grad_color, style->body.main_color, (255 * i) / line_cnt);
+        }
+
+        lv_draw_line(&p1, &p2, mask, &style_tmp, opa_scale);
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -249,70 +328,8 @@ static bool lv_lmeter_design(lv_obj_t * lmeter, const lv_area_t * mask, lv_desig
     }
     /*Draw the object*/
     else if(mode == LV_DESIGN_DRAW_MAIN) {
-        lv_lmeter_ext_t * ext    = lv_obj_get_ext_attr(lmeter);
-        const lv_style_t * style = lv_obj_get_style(lmeter);
-        lv_opa_t opa_scale       = lv_obj_get_opa_scale(lmeter);
-        lv_style_t style_tmp;
-        lv_style_copy(&style_tmp, style);
-
-#if LV_USE_GROUP
-        lv_group_t * g = lv_obj_get_group(lmeter);
-        if(lv_group_get_focused(g) == lmeter) {
-            style_tmp.line.width += 1;
-        }
-#endif
-
-        lv_coord_t r_out = lv_obj_get_width(lmeter) / 2;
-        lv_coord_t r_in  = r_out - style->body.padding.left;
-        if(r_in < 1) r_in = 1;
-
-        lv_coord_t x_ofs  = lv_obj_get_width(lmeter) / 2 + lmeter->coords.x1;
-        lv_coord_t y_ofs  = lv_obj_get_height(lmeter) / 2 + lmeter->coords.y1;
-        int16_t angle_ofs = 90 + (360 - ext->scale_angle) / 2;
-        int16_t level =
-            (int32_t)((int32_t)(ext->cur_value - ext->min_value) * ext->line_cnt) / (ext->max_value - ext->min_value);
-        uint8_t i;
-
-        style_tmp.line.color = style->body.main_color;
-
-        /*Calculate every coordinate in a bigger size to make rounding later*/
-        r_out = r_out << LV_LMETER_LINE_UPSCALE;
-        r_in  = r_in << LV_LMETER_LINE_UPSCALE;
-
-        for(i = 0; i < ext->line_cnt; i++) {
-            /*Calculate the position a scale label*/
-            int16_t angle = (i * ext->scale_angle) / (ext->line_cnt - 1) + angle_ofs;
-
-            lv_coord_t y_out = (int32_t)((int32_t)lv_trigo_sin(angle) * r_out) >> LV_TRIGO_SHIFT;
-            lv_coord_t x_out = (int32_t)((int32_t)lv_trigo_sin(angle + 90) * r_out) >> LV_TRIGO_SHIFT;
-            lv_coord_t y_in  = (int32_t)((int32_t)lv_trigo_sin(angle) * r_in) >> LV_TRIGO_SHIFT;
-            lv_coord_t x_in  = (int32_t)((int32_t)lv_trigo_sin(angle + 90) * r_in) >> LV_TRIGO_SHIFT;
-
-            /*Rounding*/
-            x_out = lv_lmeter_coord_round(x_out);
-            x_in  = lv_lmeter_coord_round(x_in);
-            y_out = lv_lmeter_coord_round(y_out);
-            y_in  = lv_lmeter_coord_round(y_in);
-
-            lv_point_t p1;
-            lv_point_t p2;
-
-            p2.x = x_in + x_ofs;
-            p2.y = y_in + y_ofs;
-
-            p1.x = x_out + x_ofs;
-            p1.y = y_out + y_ofs;
-
-            if(i >= level)
-                style_tmp.line.color = style->line.color;
-            else {
-                style_tmp.line.color =
-                    lv_color_mix(style->body.grad_color, style->body.main_color, (255 * i) / ext->line_cnt);
-            }
-
-            lv_draw_line(&p1, &p2, mask, &style_tmp, opa_scale);
-        }
-
+        lv_lmeter_ext_t * ext = lv_obj_get_ext_attr(lmeter);
+        lv_lmeter_draw_lines(lmeter, mask, lv_obj_get_style(lmeter), ext->line_cnt);
     }
     /*Post draw when the children are drawn*/
     else if(mode == LV_DESIGN_DRAW_POST) {
@@ -151,6 +151,21 @@ static inline const lv_style_t * lv_lmeter_get_style(const lv_obj_t * lmeter, lv
     return lv_obj_get_style(lmeter);
 }
 
+/*=====================
+ * Other functions
+ *====================*/
+
+/**
+ * Draw the lines of a line meter with a given style and line count.
+ * Used by the line meter and by objects which draw more lines over it (e.g. gauge)
+ * without modifying the object while it's being drawn.
+ * @param lmeter pointer to a line meter object
+ * @param mask the lines will be drawn only in this area
+ * @param style style to draw with (`body.padding.left` is the line length)
+ * @param line_cnt number of lines
+ */
+void lv_lmeter_draw_lines(lv_obj_t * lmeter, const lv_area_t * mask, const lv_style_t * style, uint8_t line_cnt);
+
 /**********************
  *      MACROS
  **********************/
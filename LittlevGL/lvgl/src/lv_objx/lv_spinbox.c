@@ -309,6 +309,7 @@ static lv_res_t lv_spinbox_signal(lv_obj_t * spinbox, lv_signal_t sign, void * p
 {
 
     lv_spinbox_ext_t * ext = lv_obj_get_ext_attr(spinbox);
+    (void)ext; /*Unused if LV_USE_GROUP == 0*/
 
     lv_res_t res = LV_RES_OK;
 
@@ -0,0 +1,189 @@
+/**
+ * @file blend_test.c
+ * Compare the blending kernels of `lv_draw_blend.c` with `lv_color_mix` bit by bit.
+ * Built for each color depth by setting `LV_COLOR_DEPTH` (see test.mak).
+ * With `LV_DRAW_SIMD` the vector kernels of the compiling machine (SSE2 or NEON) are tested.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl/src/lv_draw/lv_draw_blend.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CASE_CNT 20000
+#define LEN_MAX 70 /*Several vectors and a tail*/
+#define OFS_MAX 7  /*Unaligned starts*/
+#define BUF_SIZE (LEN_MAX + OFS_MAX)
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t rnd(void);
+static lv_opa_t rnd_opa(void);
+static lv_color_t rnd_color(void);
+static void rnd_colors(lv_color_t * buf, uint32_t length);
+static void ref_fill_opa(lv_color_t * dest, uint32_t length, lv_color_t color, lv_opa_t opa);
+static void ref_map(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa);
+static void ref_map_alpha(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * alpha, uint32_t length);
+static bool check(const char * name, uint32_t test_case, const lv_color_t * res, const lv_color_t * ref,
+                  uint32_t length);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t rnd_state = 0x12345678;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(void)
+{
+    static lv_color_t dest[BUF_SIZE];
+    static lv_color_t ref[BUF_SIZE];
+    static lv_color_t src[BUF_SIZE];
+    static lv_opa_t alpha[BUF_SIZE];
+    uint32_t fail_cnt = 0;
+    uint32_t c;
+
+    for(c = 0; c < CASE_CNT; c++) {
+        uint32_t length = rnd() % (LEN_MAX + 1);
+        uint32_t ofs    = rnd() % (OFS_MAX + 1);
+        lv_color_t color = rnd_color();
+        lv_opa_t opa     = rnd_opa();
+        uint32_t i;
+
+        rnd_colors(dest, BUF_SIZE);
+        rnd_colors(src, BUF_SIZE);
+        for(i = 0; i < BUF_SIZE; i++) alpha[i] = rnd_opa();
+
+        memcpy(ref, dest, sizeof(ref));
+        lv_blend_fill_opa(&dest[ofs], length, color, opa);
+        ref_fill_opa(&ref[ofs], length, color, opa);
+        if(!check("lv_blend_fill_opa", c, dest, ref, BUF_SIZE)) fail_cnt++;
+
+        memcpy(ref, dest, sizeof(ref));
+        lv_blend_map(&dest[ofs], &src[OFS_MAX - ofs], length, opa);
+        ref_map(&ref[ofs], &src[OFS_MAX - ofs], length, opa);
+        if(!check("lv_blend_map", c, dest, ref, BUF_SIZE)) fail_cnt++;
+
+        memcpy(ref, dest, sizeof(ref));
+        lv_blend_map_alpha(&dest[ofs], &src[ofs], &alpha[ofs], length);
+        ref_map_alpha(&ref[ofs], &src[ofs], &alpha[ofs], length);
+        if(!check("lv_blend_map_alpha", c, dest, ref, BUF_SIZE)) fail_cnt++;
+    }
+
+    printf("lv_blend %d bit: %u cases, %u failed\n", LV_COLOR_DEPTH, (unsigned int)CASE_CNT,
+           (unsigned int)fail_cnt);
+
+    return fail_cnt == 0 ? 0 : 1;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Pseudo random number generator (xorshift), the same sequence on every run
+ * @return the next number
+ */
+static uint32_t rnd(void)
+{
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+    return rnd_state;
+}
+
+/**
+ * Random opacity, LV_OPA_TRANSP and LV_OPA_COVER are frequent like in real images
+ * @return an opacity
+ */
+static lv_opa_t rnd_opa(void)
+{
+    uint32_t r = rnd() % 4;
+    if(r == 0) return LV_OPA_TRANSP;
+    if(r == 1) return LV_OPA_COVER;
+    return rnd() & 0xFF;
+}
+
+/**
+ * Random color, all the bits (e.g. alpha of 32 bit colors) are random
+ * @return a color
+ */
+static lv_color_t rnd_color(void)
+{
+    lv_color_t color;
+    uint32_t r = rnd();
+    memcpy(&color, &r, sizeof(color));
+    return color;
+}
+
+/**
+ * Fill a buffer with random colors. Runs of the same color are frequent like on the screen.
+ * @param buf pointer to a buffer
+ * @param length number of colors
+ */
+static void rnd_colors(lv_color_t * buf, uint32_t length)
+{
+    lv_color_t color = rnd_color();
+    uint32_t i;
+    for(i = 0; i < length; i++) {
+        if(rnd() % 4 == 0) color = rnd_color();
+        buf[i] = color;
+    }
+}
+
+static void ref_fill_opa(lv_color_t * dest, uint32_t length, lv_color_t color, lv_opa_t opa)
+{
+    uint32_t i;
+    for(i = 0; i < length; i++) {
+        dest[i] = lv_color_mix(color, dest[i], opa);
+    }
+}
+
+static void ref_map(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa)
+{
+    uint32_t i;
+    for(i = 0; i < length; i++) {
+        dest[i] = opa == LV_OPA_COVER ? src[i] : lv_color_mix(src[i], dest[i], opa);
+    }
+}
+
+static void ref_map_alpha(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * alpha, uint32_t length)
+{
+    uint32_t i;
+    for(i = 0; i < length; i++) {
+        if(alpha[i] == LV_OPA_TRANSP) continue;
+        dest[i] = alpha[i] == LV_OPA_COVER ? src[i] : lv_color_mix(src[i], dest[i], alpha[i]);
+    }
+}
+
+/**
+ * Compare the result of a kernel with the reference. Print the first different pixel.
+ * @param name name of the kernel
+ * @param test_case index of the test case
+ * @param res pixels given by the kernel
+ * @param ref pixels given by the reference
+ * @param length number of pixels to compare (the whole buffer to check the pixels around too)
+ * @return true: the same
+ */
+static bool check(const char * name, uint32_t test_case, const lv_color_t * res, const lv_color_t * ref,
+                  uint32_t length)
+{
+    uint32_t i;
+    for(i = 0; i < length; i++) {
+        if(memcmp(&res[i], &ref[i], sizeof(lv_color_t)) != 0) {
+            printf("%s: case %u pixel %u: 0x%08x instead of 0x%08x\n", name, (unsigned int)test_case,
+                   (unsigned int)i, (unsigned int)res[i].full, (unsigned int)ref[i].full);
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file map_bench.c
+ * Measure `lv_draw_map` on the `tritech_logo` image with the flags images are drawn with.
+ * Usage: map-bench.exe [draws per case]
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl/lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define HOR_RES 240
+#define VER_RES 160
+#define BUF_SIZE (HOR_RES * VER_RES)
+#define DEF_DRAW_CNT 2000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct
+{
+    const char * name;
+    bool alpha_byte;
+    bool chroma_key;
+    lv_opa_t opa;
+    lv_opa_t recolor_opa;
+} map_case_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void make_alpha_map(void);
+static void flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+LV_IMG_DECLARE(tritech_logo);
+
+static lv_color_t vdb[BUF_SIZE];
+
+/*The logo with an alpha byte after each pixel, the logo has no alpha channel itself*/
+static uint8_t alpha_map[185 * 40 * LV_IMG_PX_SIZE_ALPHA_BYTE];
+
+static const map_case_t cases[] = {
+    {"copy", false, false, LV_OPA_COVER, LV_OPA_TRANSP},
+    {"opa", false, false, LV_OPA_50, LV_OPA_TRANSP},
+    {"chroma key", false, true, LV_OPA_COVER, LV_OPA_TRANSP},
+    {"recolor", false, false, LV_OPA_COVER, LV_OPA_50},
+    {"alpha", true, false, LV_OPA_COVER, LV_OPA_TRANSP},
+    {"alpha + opa", true, false, LV_OPA_50, LV_OPA_TRANSP},
+    {"alpha + recolor", true, false, LV_OPA_COVER, LV_OPA_50},
+};
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char * argv[])
+{
+    static lv_disp_buf_t disp_buf;
+    uint32_t draw_cnt = argc > 1 ? (uint32_t)atoi(argv[1]) : DEF_DRAW_CNT;
+    if(draw_cnt == 0) {
+        printf("Usage: %s [draws per case]\n", argv[0]);
+        return 1;
+    }
+
+    lv_init();
+    lv_disp_buf_init(&disp_buf, vdb, NULL, BUF_SIZE);
+
+    lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res  = HOR_RES;
+    disp_drv.ver_res  = VER_RES;
+    disp_drv.buffer   = &disp_buf;
+    disp_drv.flush_cb = flush;
+    lv_disp_t * disp  = lv_disp_drv_register(&disp_drv);
+
+    /*Draw directly into the VDB like during a refresh*/
+    lv_refr_set_disp_refreshing(disp);
+    lv_area_set(&disp_buf.area, 0, 0, HOR_RES - 1, VER_RES - 1);
+
+    make_alpha_map();
+
+    lv_area_t coords;
+    lv_area_set(&coords, 20, 30, 20 + tritech_logo.header.w - 1, 30 + tritech_logo.header.h - 1);
+
+    printf("lv_draw_map: %dx%d tritech_logo, %u draws per case\n", tritech_logo.header.w, tritech_logo.header.h,
+           (unsigned int)draw_cnt);
+
+    uint32_t c;
+    for(c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        const map_case_t * mc = &cases[c];
+        const uint8_t * map_p = mc->alpha_byte ? alpha_map : tritech_logo.data;
+
+        memset(vdb, 0x55, sizeof(vdb));
+
+        struct timespec start;
+        struct timespec end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        uint32_t i;
+        for(i = 0; i < draw_cnt; i++) {
+            lv_draw_map(&coords, &disp_buf.area, map_p, mc->opa, mc->chroma_key, mc->alpha_byte, LV_COLOR_RED,
+                        mc->recolor_opa);
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double us = (end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3;
+        printf("%-16s: %8.1f us/draw\n", mc->name, us / draw_cnt);
+    }
+
+    return 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Add an alpha byte to each pixel of the logo: transparent on the white background,
+ * opaque on the dark parts and gradual on the anti-aliased edges
+ */
+static void make_alpha_map(void)
+{
+    const lv_color_t * px = (const lv_color_t *)tritech_logo.data;
+    uint32_t px_cnt       = tritech_logo.header.w * tritech_logo.header.h;
+    uint32_t i;
+
+    for(i = 0; i < px_cnt; i++) {
+        uint8_t * dest = &alpha_map[i * LV_IMG_PX_SIZE_ALPHA_BYTE];
+        memcpy(dest, &px[i], sizeof(lv_color_t));
+        dest[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = LV_OPA_COVER - lv_color_brightness(px[i]);
+    }
+}
+
+static void flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    (void)area;
+    (void)color_p;
+    lv_disp_flush_ready(disp_drv);
+}
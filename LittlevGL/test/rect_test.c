@@ -0,0 +1,191 @@
+/**
+ * @file rect_test.c
+ * Compare the rectangles drawn with the corner mask cache to the ones drawn without it.
+ * `lv_draw_rect.c` is compiled a second time without the cache as `lv_draw_rect_ref` (see test.mak).
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl/lvgl.h"
+#include <stdio.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CASE_CNT 20000
+#define HOR_RES 240
+#define VER_RES 160
+#define BUF_SIZE (HOR_RES * VER_RES)
+
+/*Larger than any part of the draw buffer used by `lv_draw_rect`*/
+#define DRAW_BUF_CLEAR_SIZE (16 * 1024)
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+void lv_draw_rect_ref(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa_scale);
+static void draw(void (*draw_rect)(const lv_area_t *, const lv_area_t *, const lv_style_t *, lv_opa_t),
+                 const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa_scale);
+static void flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static uint32_t rnd(void);
+static lv_color_t rnd_color(void);
+static lv_opa_t rnd_opa(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t rnd_state = 0x12345678;
+static lv_color_t vdb[BUF_SIZE];
+static lv_color_t bg[BUF_SIZE];
+static lv_color_t ref[BUF_SIZE];
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(void)
+{
+    static lv_disp_buf_t disp_buf;
+    uint32_t fail_cnt = 0;
+    uint32_t c;
+    uint32_t i;
+
+    lv_init();
+    lv_disp_buf_init(&disp_buf, vdb, NULL, BUF_SIZE);
+
+    lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res  = HOR_RES;
+    disp_drv.ver_res  = VER_RES;
+    disp_drv.buffer   = &disp_buf;
+    disp_drv.flush_cb = flush;
+    lv_disp_t * disp  = lv_disp_drv_register(&disp_drv);
+
+    /*Draw directly into the VDB like during a refresh*/
+    lv_refr_set_disp_refreshing(disp);
+    lv_area_set(&disp_buf.area, 0, 0, HOR_RES - 1, VER_RES - 1);
+
+    for(i = 0; i < BUF_SIZE; i++) bg[i] = rnd_color();
+
+    for(c = 0; c < CASE_CNT; c++) {
+        lv_style_t style;
+        lv_style_copy(&style, &lv_style_plain);
+        style.body.radius = rnd() % 8 == 0 ? LV_RADIUS_CIRCLE : rnd() % 30;
+        style.body.main_color = rnd_color();
+        style.body.grad_color = rnd() % 4 ? style.body.main_color : rnd_color();
+        style.body.opa        = rnd_opa();
+        style.body.border.width = rnd() % 4 ? rnd() % 6 : rnd() % 20;
+        style.body.border.part  = rnd() % 3 ? LV_BORDER_FULL : rnd() % 32;
+        style.body.border.opa   = rnd_opa();
+        style.body.border.color = rnd_color();
+        style.body.shadow.width = rnd() % 3 ? rnd() % 16 : 0;
+        style.body.shadow.type  = rnd() % 2 ? LV_SHADOW_FULL : LV_SHADOW_BOTTOM;
+        style.body.shadow.color = rnd_color();
+        lv_opa_t opa_scale      = rnd_opa();
+
+        /*Partly out of the screen too*/
+        lv_area_t coords;
+        coords.x1 = (lv_coord_t)(rnd() % (HOR_RES + 20)) - 20;
+        coords.y1 = (lv_coord_t)(rnd() % (VER_RES + 20)) - 20;
+        coords.x2 = coords.x1 + rnd() % 120;
+        coords.y2 = coords.y1 + rnd() % 100;
+
+        lv_area_t mask;
+        if(rnd() % 2) {
+            lv_area_copy(&mask, &disp_buf.area);
+        } else {
+            mask.x1 = rnd() % HOR_RES;
+            mask.y1 = rnd() % VER_RES;
+            mask.x2 = mask.x1 + rnd() % 200;
+            mask.y2 = mask.y1 + rnd() % 200;
+            if(mask.x2 >= HOR_RES) mask.x2 = HOR_RES - 1;
+            if(mask.y2 >= VER_RES) mask.y2 = VER_RES - 1;
+        }
+
+        disp->driver.antialiasing = rnd() % 5 ? 1 : 0;
+
+        draw(lv_draw_rect_ref, &coords, &mask, &style, opa_scale);
+        memcpy(ref, vdb, sizeof(ref));
+        draw(lv_draw_rect, &coords, &mask, &style, opa_scale);
+
+        if(memcmp(ref, vdb, sizeof(ref)) != 0) {
+            printf("case %u: radius %d, border %d (part 0x%x), shadow %d (type %d), antialias %d\n", (unsigned int)c,
+                   style.body.radius, style.body.border.width, style.body.border.part, style.body.shadow.width,
+                   style.body.shadow.type, disp->driver.antialiasing);
+            fail_cnt++;
+        }
+    }
+
+    printf("lv_draw_rect: %u cases, %u failed\n", (unsigned int)CASE_CNT, (unsigned int)fail_cnt);
+
+    return fail_cnt == 0 ? 0 : 1;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Draw a rectangle on the background
+ * @param draw_rect the drawing function to test
+ * @param coords the coordinates of the rectangle
+ * @param mask the rectangle will be drawn only in this mask
+ * @param style pointer to a style
+ * @param opa_scale scale down all opacities by the factor
+ */
+static void draw(void (*draw_rect)(const lv_area_t *, const lv_area_t *, const lv_style_t *, lv_opa_t),
+                 const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa_scale)
+{
+    memcpy(vdb, bg, sizeof(vdb));
+
+    /*`lv_draw_shadow_bottom` reads a few bytes before its blur line. Make them the same for both drawings.*/
+    memset(lv_draw_get_buf(DRAW_BUF_CLEAR_SIZE), 0, DRAW_BUF_CLEAR_SIZE);
+
+    draw_rect(coords, mask, style, opa_scale);
+}
+
+static void flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    (void)area;
+    (void)color_p;
+    lv_disp_flush_ready(disp_drv);
+}
+
+/**
+ * Pseudo random number generator (xorshift), the same sequence on every run
+ * @return the next number
+ */
+static uint32_t rnd(void)
+{
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+    return rnd_state;
+}
+
+/**
+ * Random color, black and white are frequent
+ * @return a color
+ */
+static lv_color_t rnd_color(void)
+{
+    uint32_t r = rnd() % 8;
+    if(r == 0) return LV_COLOR_BLACK;
+    if(r == 1) return LV_COLOR_WHITE;
+
+    lv_color_t color;
+    r = rnd();
+    memcpy(&color, &r, sizeof(color));
+    return color;
+}
+
+/**
+ * Random opacity, LV_OPA_COVER is frequent
+ * @return an opacity
+ */
+static lv_opa_t rnd_opa(void)
+{
+    return rnd() % 2 ? LV_OPA_COVER : rnd() & 0xFF;
+}
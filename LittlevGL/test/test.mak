@@ -0,0 +1,67 @@
+
+# Blending kernels against lv_color_mix, for each color depth with vector kernels.
+# Cross compile (e.g. CC=arm-linux-gnueabihf-gcc) to test the NEON kernels.
+$(call define-srcs, blend-test-16-main, LittlevGL/test, \
+	blend_test.c \
+)
+$(call define-srcs, blend-test-16-draw, LittlevGL/lvgl/src/lv_draw, \
+	lv_draw_blend.c \
+)
+$(call concat-objs, blend-test-16, \
+	blend-test-16-main \
+	blend-test-16-draw \
+)
+$(call apply-cppflags, blend-test-16, \
+	-ILittlevGL \
+	-Wundef \
+	-DLV_COLOR_DEPTH=16 \
+)
+
+$(call define-srcs, blend-test-32-main, LittlevGL/test, \
+	blend_test.c \
+)
+$(call define-srcs, blend-test-32-draw, LittlevGL/lvgl/src/lv_draw, \
+	lv_draw_blend.c \
+)
+$(call concat-objs, blend-test-32, \
+	blend-test-32-main \
+	blend-test-32-draw \
+)
+$(call apply-cppflags, blend-test-32, \
+	-ILittlevGL \
+	-Wundef \
+	-DLV_COLOR_DEPTH=32 \
+)
+
+# Rectangles drawn with the corner mask cache against the ones drawn without it
+$(call define-srcs, rect-test-main, LittlevGL/test, \
+	rect_test.c \
+)
+$(call apply-cppflags, rect-test-main, \
+	-ILittlevGL \
+	-Wundef \
+)
+
+$(call define-srcs, rect-test-ref, LittlevGL/lvgl/src/lv_draw, \
+	lv_draw_rect.c \
+)
+$(call apply-cppflags, rect-test-ref, \
+	-ILittlevGL \
+	-Wundef \
+	-DLV_DRAW_CORNER_CACHE_CNT=0 \
+	-Dlv_draw_rect=lv_draw_rect_ref \
+)
+
+$(call concat-objs, rect-test, \
+	rect-test-main \
+	rect-test-ref \
+)
+
+# lv_draw_map microbenchmark on the tritech_logo image
+$(call define-srcs, map-bench, LittlevGL/test, \
+	map_bench.c \
+)
+$(call apply-cppflags, map-bench, \
+	-ILittlevGL \
+	-Wundef \
+)
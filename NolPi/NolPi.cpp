@@ -1,18 +1,39 @@
+#include <algorithm>
+
 #include "NolPi/NolPi.h"
 
+////////////////////////////////////////////////////////////////////////////
+//               Global definitions
+////////////////////////////////////////////////////////////////////////////
+
+// Rate of the simulated temperature sensor, the GUI coalesces the samples
+static constexpr int SAMPLE_RATE_HZ = 200;
+
+// Longest sleep when waiting for a replayed sample
+static constexpr std::chrono::milliseconds REPLAY_SLEEP{100};
+
 ////////////////////////////////////////////////////////////////////////////
 //               Public member functions
 /////////////////////////////////////////////////////////////////////////////
 
 ////////////////////////////////////////////////////////////////
 
-NolPi::NolPi()
+NolPi::NolPi(NolPiSessionLog *log) :
+   m_pSessionLog(log)
 {
    // Create user interface
-   m_Gui = new NolPiGui();
+   m_Gui = new NolPiGui(log);
 
-   // Create the temperature generating thread
-   m_TemperatureThread = new std::thread([this]{this->TemperatureHandler();});
+   // Create the temperature generating thread,
+   // replays the recorded samples instead if replaying a session.
+   if ( m_pSessionLog && m_pSessionLog->Replaying() )
+   {
+      m_TemperatureThread = new std::thread([this]{this->TemperatureReplay();});
+   }
+   else
+   {
+      m_TemperatureThread = new std::thread([this]{this->TemperatureHandler();});
+   }
 }
 
 ////////////////////////////////////////////////////////////////
@@ -39,29 +60,59 @@ void NolPi::TemperatureHandler()
 {
    int temp = 0;
    int incr = 1;
+   int samples = 0;
 
    // Executed as thread, until disabled
-   // Ramp temperature cyclic in interval 0 -> 35 -> 0
+   // Ramp temperature cyclic in interval 0 -> 35 -> 0, one degree per second
    while (m_TemperatureEnable)
    {
       if (m_Gui->SimulateTempActive())
       {
          m_Gui->SetCurrentTemp(temp);
-         temp += incr;
-         if (temp >= NolPiGui::MAX_TEMP)
+         if (++samples >= SAMPLE_RATE_HZ)
          {
-            incr = -1;
-         }
-         if (temp <= 0)
-         {
-            incr = 1;
+            samples = 0;
+            temp += incr;
+            if (temp >= NolPiGui::MAX_TEMP)
+            {
+               incr = -1;
+            }
+            if (temp <= 0)
+            {
+               incr = 1;
+            }
          }
       }
       else
       {
          temp = 0;
          incr = 1;
+         samples = 0;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1000 / SAMPLE_RATE_HZ));
+   }
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPi::TemperatureReplay()
+{
+   int value;
+   std::chrono::steady_clock::time_point due;
+
+   // Executed as thread, until disabled or all samples are replayed
+   while ( m_TemperatureEnable && m_pSessionLog->NextTemp(value, due) )
+   {
+      // Sleep in short steps to not delay the destruction
+      while ( m_TemperatureEnable && (std::chrono::steady_clock::now() < due) )
+      {
+         std::this_thread::sleep_until(
+            std::min(due, std::chrono::steady_clock::now() + REPLAY_SLEEP));
+      }
+
+      if (m_TemperatureEnable)
+      {
+         m_Gui->SetCurrentTemp(value);
       }
-      std::this_thread::sleep_for(std::chrono::seconds(1));
    }
 }
@@ -2,23 +2,27 @@
 #define _NOLPI_H_
 
 #include <thread>
+#include <atomic>
 
 #include "NolPi/NolPiGui.h"
 
 class NolPi
 {
 public:
-   NolPi();
+   explicit NolPi(NolPiSessionLog *log = nullptr);
    ~NolPi();
 
 private:
    NolPiGui *m_Gui{nullptr};
 
-   bool         m_TemperatureEnable{true};
-   std::thread *m_TemperatureThread{nullptr};
+   NolPiSessionLog *m_pSessionLog{nullptr};
+
+   std::atomic<bool>  m_TemperatureEnable{true};
+   std::thread       *m_TemperatureThread{nullptr};
 
 private:
    void TemperatureHandler();
+   void TemperatureReplay();
 };
 
 #endif // _NOLPI_H
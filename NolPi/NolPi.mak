@@ -3,6 +3,10 @@ $(call define-srcs, nolpi, NolPi, \
 	main.cpp \
 	NolPi.cpp \
 	NolPiGui.cpp \
+	NolPiGuiCmdQueue.cpp \
+	NolPiTempIngest.cpp \
+	NolPiSessionLog.cpp \
+	NolPiMetrics.cpp \
 )
 
 # Notes:
@@ -16,3 +20,26 @@ $(call apply-cppflags, nolpi, \
 	-ILittlevGL \
 	-Wno-narrowing \
 )
+
+# NolPi rendering into memory with scripted touches, for benchmarking
+$(call define-srcs, nolpi-headless, NolPi, \
+	main_headless.cpp \
+	NolPi.cpp \
+	NolPiGui.cpp \
+	NolPiGuiCmdQueue.cpp \
+	NolPiTempIngest.cpp \
+	NolPiSessionLog.cpp \
+	NolPiMetrics.cpp \
+)
+
+$(call apply-cppflags, nolpi-headless, \
+	-ILittlevGL \
+	-Wno-narrowing \
+	-DNOLPI_HEADLESS \
+)
+
+# Reader of the metrics published by NolPi
+$(call define-srcs, nolpi-stats, NolPi, \
+	main_stats.cpp \
+	NolPiMetrics.cpp \
+)
@@ -1,13 +1,20 @@
 #include <pthread.h>
 #include <sched.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
 
 #include <chrono>
-#include <functional>
+#include <cstdio>
+#include <cstring>
 
 #include "NolPi/NolPiGui.h"
 #include "NolPi/PcEnv.h"
 
-#if defined PCENV
+#if defined NOLPI_HEADLESS
+#include "LittlevGL/lv_drivers/display/headless.h"
+#include "LittlevGL/lv_drivers/indev/touch_script.h"
+#elif defined PCENV
 #include "LittlevGL/lv_drivers/display/monitor.h"
 #include "LittlevGL/lv_drivers/indev/mouse.h"
 #else
@@ -19,11 +26,20 @@
 //               Global definitions
 ////////////////////////////////////////////////////////////////////////////
 
-// LittlevGL task period times
-static constexpr unsigned int TICK_PERIOD_MS = 5;
-static constexpr unsigned int TASK_PERIOD_MS = 10;
+// Longest time the task handler sleeps, even if no lv_task is due
+static constexpr unsigned int MAX_IDLE_MS = 1000;
 
-static constexpr int PRELOAD_TIME_S = 5;
+// Max number of posted commands executed before each lv_task_handler call
+static constexpr unsigned int CMD_BATCH_SIZE = 32;
+
+// Number of screens kept when not shown, and the LittlevGL memory usage
+// above which they are destroyed anyway.
+static constexpr unsigned int MAX_CACHED_SCREENS = 2;
+static constexpr unsigned int SCREEN_EVICT_USED_PCT = 80;
+
+// Update period of the metrics overlay, also how often it's checked if
+// a reader of the metrics has requested it.
+static constexpr uint32_t OVERLAY_PERIOD_MS = 1000;
 
 // Temperature definitions
 static constexpr int DEG_PER_INTERVAL = 5;
@@ -31,14 +47,35 @@ static constexpr int DEG_PER_INTERVAL = 5;
 static constexpr int IDX_CURRENT_TEMP = 0;
 static constexpr int IDX_WARNING_TEMP = 1;
 
+// Chart only, the envelope of the samples in a column
+static constexpr int IDX_MIN_TEMP = 2;
+static constexpr int IDX_MAX_TEMP = 3;
+
 static constexpr int DEFAULT_CURRENT_TEMP = 20;
 static constexpr int DEFAULT_WARNING_TEMP = 25;
 
-static constexpr int NR_TEMP_POINTS = 20;
-
 // Custom widgets for LittlevGL
 LV_IMG_DECLARE(tritech_logo);
 
+// Work done while the preloader is shown, one step each frame
+const NolPiGui::PreloadStep NolPiGui::PRELOAD_STEPS[] =
+{
+   {"Main",  &NolPiGui::PreloadMainScreen},
+   {"Chart", &NolPiGui::PreloadChartScreen},
+   {"Layers", &NolPiGui::PreloadLayers},
+};
+
+const unsigned int NolPiGui::NR_PRELOAD_STEPS =
+   sizeof(NolPiGui::PRELOAD_STEPS) / sizeof(NolPiGui::PRELOAD_STEPS[0]);
+
+// Screens created on demand
+const NolPiGui::ScreenInfo NolPiGui::SCREENS[NolPiGui::NR_SCREENS] =
+{
+   {&NolPiGui::m_pScreenMain,  &NolPiGui::CreateMainScreen,  &NolPiGui::DestroyMainScreen},
+   {&NolPiGui::m_pScreenChart, &NolPiGui::CreateChartScreen, &NolPiGui::DestroyChartScreen},
+   {&NolPiGui::m_pScreenImage, &NolPiGui::CreateImageScreen, &NolPiGui::DestroyImageScreen},
+};
+
 static constexpr lv_coord_t ANIM_X_MIN = 10;
 static constexpr lv_coord_t ANIM_X_MAX = 290;
 
@@ -54,17 +91,22 @@ static constexpr lv_coord_t ANIM_Y_START = 138;
 
 ////////////////////////////////////////////////////////////////
 
-NolPiGui::NolPiGui()
+NolPiGui::NolPiGui(NolPiSessionLog *log) :
+   m_pSessionLog(log)
 {
    // Create user interface
    InitGraphics();
    CreateGUI();
+
+   // From now on LittlevGL is only accessed from the task handler thread
+   StartThreads();
 }
 
 ////////////////////////////////////////////////////////////////
 
 NolPiGui::~NolPiGui()
 {
+   StopThreads();
    DestroyGUI();
    ExitGraphics();
 }
@@ -83,7 +125,7 @@ void NolPiGui::StartEntry()
    lv_cb_set_checked(m_pSimulateCheckbox, false);
    m_Simulate = false;
 
-   SetCurrentTemp(DEFAULT_CURRENT_TEMP);
+   SetTemp(IDX_CURRENT_TEMP, DEFAULT_CURRENT_TEMP);
    SetWarningTemp(DEFAULT_WARNING_TEMP);
 
    OpenEntryScreen();
@@ -121,7 +163,20 @@ void NolPiGui::StartImage()
 
 void NolPiGui::SetCurrentTemp(int value)
 {
-   SetTemp(IDX_CURRENT_TEMP, value);
+   // Only the first sample after the GUI found the ring empty is posted,
+   // the GUI then keeps collecting samples once per frame until idle.
+   if ( m_pSessionLog && m_pSessionLog->Recording() )
+   {
+      m_pSessionLog->RecordTemp(value);
+   }
+
+   if (m_TempIngest.Push(value))
+   {
+      NolPiGuiCmd cmd;
+      cmd.type = NolPiGuiCmd::TEMP_SAMPLES;
+
+      PostCmd(cmd);
+   }
 }
 
 ///////////////////////////////////////////////////////////////
@@ -129,7 +184,10 @@ void NolPiGui::SetCurrentTemp(int value)
 void NolPiGui::SetWarningTemp(int value)
 {
    SetTemp(IDX_WARNING_TEMP, value);
-   lv_slider_set_value(m_pWarningSlider, m_WarningTemp, LV_ANIM_OFF);
+   if (m_pWarningSlider != NULL)
+   {
+      lv_slider_set_value(m_pWarningSlider, m_WarningTemp, LV_ANIM_OFF);
+   }
 }
 
 ///////////////////////////////////////////////////////////////
@@ -188,6 +246,7 @@ lv_obj_t* NolPiGui::GetImageCustomImage()
    return m_pImageCustomImage;
 }
 
+
 ////////////////////////////////////////////////////////////////////////////
 //               Private member functions
 ////////////////////////////////////////////////////////////////////////////
@@ -199,7 +258,11 @@ void NolPiGui::InitGraphics()
    // Initialize LittlevGL
    lv_init();
 
-#if defined PCENV
+#if defined NOLPI_HEADLESS
+   // Use the 'headless' driver.
+   // Renders into memory, for benchmarking.
+   headless_init();
+#elif defined PCENV
    // Use the 'monitor' driver.
    // Creates a SDL window on PC's monitor to simulate a display.
    monitor_init();
@@ -209,31 +272,81 @@ void NolPiGui::InitGraphics()
    fbdev_init();
 #endif
 
-   // Initialize the display buffer
-   m_pDrawBuffer = new lv_color_t[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+   // Initialize the display buffer.
+   // Render directly into the framebuffer if it's double buffered,
+   // flushing then only shows the rendered buffer instead of copying it.
+   void *buf1 = nullptr;
+   void *buf2 = nullptr;
+   uint32_t bufSize = LV_HOR_RES_MAX * LV_VER_RES_MAX;
+#if !defined PCENV && !defined NOLPI_HEADLESS
+   if (!fbdev_get_double_buf(LV_HOR_RES_MAX, LV_VER_RES_MAX, &buf1, &buf2))
+   {
+      // Two partial draw buffers, one is rendered while the framebuffer
+      // driver copies the other.
+      bufSize = LV_HOR_RES_MAX * DRAW_BUFFER_ROWS;
+      m_pDrawBuffer = new lv_color_t[2 * bufSize];
+      buf1 = m_pDrawBuffer;
+      buf2 = m_pDrawBuffer + bufSize;
+   }
+#endif
+   if (buf1 == nullptr)
+   {
+      m_pDrawBuffer = new lv_color_t[bufSize];
+      buf1 = m_pDrawBuffer;
+   }
    lv_disp_buf_init(&m_DisplayBuffer,
-                    m_pDrawBuffer,
-                    NULL,
-                    LV_HOR_RES_MAX * LV_VER_RES_MAX);
+                    buf1,
+                    buf2,
+                    bufSize);
+
+   // Not needed if the framebuffer is rendered directly
+   if (m_pDrawBuffer != nullptr)
+   {
+      m_pDiffBuffer = new lv_color_t[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+   }
+
+   // Published for other processes, collected even if not possible
+   m_Metrics.Open();
 
    // Register the display driver to LittlecGL
    lv_disp_drv_t dispDrv;
    lv_disp_drv_init(&dispDrv);
-   dispDrv.hor_res  = LV_HOR_RES_MAX;
-   dispDrv.ver_res  = LV_VER_RES_MAX;
-   dispDrv.buffer   = &m_DisplayBuffer;
-#if defined PCENV
-   dispDrv.flush_cb = monitor_flush;
+   dispDrv.hor_res    = LV_HOR_RES_MAX;
+   dispDrv.ver_res    = LV_VER_RES_MAX;
+   dispDrv.buffer     = &m_DisplayBuffer;
+   dispDrv.flush_cb   = DisplayFlush;
+   dispDrv.monitor_cb = DisplayMonitor;
+   dispDrv.diff_buf   = m_pDiffBuffer;
+   dispDrv.user_data  = this;
+   dispDrv.flush_ready_cb = DisplayFlushReady; // Ends the flush, maybe in an other thread
+#if defined NOLPI_HEADLESS
+   m_DisplayFlush   = headless_flush;
+   m_DisplayMonitor = headless_monitor;
+   dispDrv.copy_cb  = headless_copy; // Moves objects without redrawing them
+#elif defined PCENV
+   m_DisplayFlush = monitor_flush;
 #else
-   dispDrv.flush_cb = fbdev_flush;
+   m_DisplayFlush = fbdev_flush;
+   dispDrv.wait_cb = DisplayWait; // Sleeps until the flush thread is ready
+   m_DisplayWait = fbdev_wait;
+   dispDrv.copy_cb = fbdev_copy; // Moves objects without redrawing them
+   dispDrv.vsync_cb = DisplayVsync; // Starts the frames at the vertical sync
+   m_DisplayVsync = fbdev_vsync;
 #endif
    lv_disp_t *monitorDisp = lv_disp_drv_register(&dispDrv);
    if (monitorDisp == NULL)
    {
       printf("%s : can't register display driver\n", __func__);
    }
+   else
+   {
+      // Measures the whole refresh, monitor_cb only gets milliseconds
+      lv_task_set_cb(monitorDisp->refr_task, RefreshTask);
+   }
 
-#if defined PCENV
+#if defined NOLPI_HEADLESS
+   // Touches are played from a script set by the application
+#elif defined PCENV
    // Use the 'mouse' driver.
    // Reads the PC's mouse.
    mouse_init();
@@ -246,42 +359,59 @@ void NolPiGui::InitGraphics()
    // Register the input device driver to LittlevGL
    lv_indev_drv_t indevDrv;
    lv_indev_drv_init(&indevDrv);
-   indevDrv.type    = LV_INDEV_TYPE_POINTER;
-#if defined PCENV
-   indevDrv.read_cb = mouse_read;
+   indevDrv.type      = LV_INDEV_TYPE_POINTER;
+   indevDrv.read_cb   = InputRead;
+   indevDrv.user_data = this;
+#if defined NOLPI_HEADLESS
+   m_InputRead = touch_script_read;
+#elif defined PCENV
+   m_InputRead = mouse_read;
 #else
-   indevDrv.read_cb = evdev_read;
+   m_InputRead = evdev_read;
 #endif
-   lv_indev_t *mouseIndev = lv_indev_drv_register(&indevDrv);
-   if (mouseIndev == NULL)
+   m_pIndev = lv_indev_drv_register(&indevDrv);
+   if (m_pIndev == NULL)
    {
       printf("%s : can't register input device driver\n", __func__);
    }
 
-   // Create LittlevGL threads
-   m_TickHandlerThread = new std::thread([this]{this->TickHandler();});
-   m_TaskHandlerThread = new std::thread([this]{this->TaskHandler();});
+#if !defined PCENV && !defined NOLPI_HEADLESS
+   // The touchscreen can be waited for, the PC's mouse must be polled.
+   // Replayed input must be polled as well.
+   if ( (m_pSessionLog == nullptr) || !m_pSessionLog->Replaying() )
+   {
+      m_InputFd = evdev_get_fd();
+   }
+#endif
+
+   // Used to wake up the task handler thread when commands are posted
+   m_WakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+   if (m_WakeupFd == -1)
+   {
+      printf("%s : can't create wakeup eventfd\n", __func__);
+   }
 }
 
 ///////////////////////////////////////////////////////////////
 
 void NolPiGui::ExitGraphics()
 {
-   // Stop LittlevGL threads
-   m_RunThreads = false;
-   if (m_TickHandlerThread)
+   if (m_WakeupFd != -1)
    {
-      m_TickHandlerThread->join();
-      delete m_TickHandlerThread;
-   }
-   if (m_TaskHandlerThread)
-   {
-      m_TaskHandlerThread->join();
-      delete m_TaskHandlerThread;
+      close(m_WakeupFd);
    }
 
+   // Join the rendering threads and free the draw buffers
+   lv_refr_deinit();
+
+#if !defined PCENV && !defined NOLPI_HEADLESS
+   // Restores the console
+   fbdev_exit();
+#endif
+
    // Destroy the display buffer
    delete[] m_pDrawBuffer;
+   delete[] m_pDiffBuffer;
 }
 
 ///////////////////////////////////////////////////////////////
@@ -295,12 +425,38 @@ void NolPiGui::CreateGUI()
       printf("%s : can't get first active screen\n", __func__);
    }
 
+   // Temperature state, shown by the screens when they are created
+   m_CurrentTemp = DEFAULT_CURRENT_TEMP;
+   m_WarningTemp = DEFAULT_WARNING_TEMP;
+   for (int i=0; i < NR_TEMP_POINTS; ++i)
+   {
+      m_CurrentHistory[i] = LV_CHART_POINT_DEF;
+      m_WarningHistory[i] = LV_CHART_POINT_DEF;
+      m_MinHistory[i]     = LV_CHART_POINT_DEF;
+      m_MaxHistory[i]     = LV_CHART_POINT_DEF;
+   }
+
+   // The other screens are created on demand
    CreateEntryScreen();
-   CreateMainScreen();
-   CreateChartScreen();
-   CreateImageScreen();
 
-   m_PreloadThread = new std::thread([this]{this->PreloadHandler();});
+   // Applies the temperature samples, resumed when samples are posted
+   m_TempBatch.columns.reserve(NR_TEMP_POINTS);
+   m_pTempTask = lv_task_create(TempIngestTask,
+                                LV_DISP_DEF_REFR_PERIOD,
+                                LV_TASK_PRIO_OFF,
+                                this);
+
+   // Runs the preload steps when started, one step each frame
+   m_pPreloadTask = lv_task_create(PreloadTask,
+                                   0,
+                                   LV_TASK_PRIO_OFF,
+                                   this);
+
+   // Shows the metrics when requested by a reader of the metrics
+   m_pOverlayTask = lv_task_create(OverlayTask,
+                                   OVERLAY_PERIOD_MS,
+                                   LV_TASK_PRIO_LOW,
+                                   this);
 
    // Start with entry screen
    OpenEntryScreen();
@@ -310,23 +466,66 @@ void NolPiGui::CreateGUI()
 
 void NolPiGui::DestroyGUI()
 {
+   if (m_pTempTask != NULL)
+   {
+      lv_task_del(m_pTempTask);
+      m_pTempTask = nullptr;
+   }
+
+   if (m_pPreloadTask != NULL)
+   {
+      lv_task_del(m_pPreloadTask);
+      m_pPreloadTask = nullptr;
+   }
+
+   if (m_pOverlayTask != NULL)
+   {
+      lv_task_del(m_pOverlayTask);
+      m_pOverlayTask = nullptr;
+   }
+
+   if (m_pOverlayLabel != NULL)
+   {
+      lv_obj_del(m_pOverlayLabel);
+      m_pOverlayLabel = nullptr;
+   }
+
    // Destroy all screens and widgets
 
-   DisablePreload();
+   for (int id=0; id < NR_SCREENS; ++id)
+   {
+      if (this->*SCREENS[id].screen != NULL)
+      {
+         (this->*SCREENS[id].destroy)();
+      }
+   }
 
    if (m_pScreenEntry != NULL)
    {
       lv_obj_clean(m_pScreenEntry);
    }
+}
 
-   if (m_pScreenMain != NULL)
-   {
-      lv_obj_clean(m_pScreenMain);
-   }
+///////////////////////////////////////////////////////////////
 
-   if (m_pScreenChart != NULL)
+void NolPiGui::StartThreads()
+{
+   // Create LittlevGL thread, the tick is read from CLOCK_MONOTONIC
+   m_TaskHandlerThread = new std::thread([this]{this->TaskHandler();});
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::StopThreads()
+{
+   // Stop LittlevGL thread
+   m_RunThreads = false;
+   Wakeup();
+   if (m_TaskHandlerThread)
    {
-      lv_obj_clean(m_pScreenChart);
+      m_TaskHandlerThread->join();
+      delete m_TaskHandlerThread;
+      m_TaskHandlerThread = nullptr;
    }
 }
 
@@ -358,151 +557,335 @@ void NolPiGui::SetSchedFifoPriority(int prio)
 
 ///////////////////////////////////////////////////////////////
 
-void NolPiGui::TickHandler()
+void NolPiGui::TaskHandler()
 {
    if (!PcEnv::enabled)
    {
-      SetSchedFifoPriority(90);
+      SetSchedFifoPriority(89);
    }
 
    while (m_RunThreads)
    {
-      lv_tick_inc(TICK_PERIOD_MS);
-      std::this_thread::sleep_for(std::chrono::milliseconds(TICK_PERIOD_MS));
+      // Apply updates posted by other threads, then let LittlevGL run
+      m_CmdQueue.Drain([this](const NolPiGuiCmd &cmd){this->ExecuteCmd(cmd);},
+                       CMD_BATCH_SIZE);
+      lv_task_handler();
+      SuspendIdleInput();
+
+      // Sleep until the next lv_task is due, new input or posted commands.
+      // Don't sleep if the last batch didn't drain the queue.
+      WaitForWork(m_CmdQueue.Empty() ? lv_task_get_time_till_next() : 0);
    }
 }
 
 ///////////////////////////////////////////////////////////////
 
-void NolPiGui::TaskHandler()
+void NolPiGui::WaitForWork(uint32_t timeoutMs)
 {
-   if (!PcEnv::enabled)
+   if (timeoutMs == 0)
    {
-      SetSchedFifoPriority(89);
+      return;
+   }
+   if (timeoutMs > MAX_IDLE_MS)
+   {
+      timeoutMs = MAX_IDLE_MS;
    }
 
-   while (m_RunThreads)
+   struct pollfd fds[2];
+   nfds_t nfds = 0;
+
+   if (m_WakeupFd != -1)
    {
-      lv_task_handler();
-      std::this_thread::sleep_for(std::chrono::milliseconds(TASK_PERIOD_MS));
+      fds[nfds].fd = m_WakeupFd;
+      fds[nfds].events = POLLIN;
+      fds[nfds].revents = 0;
+      nfds++;
+   }
+   if (m_InputFd != -1)
+   {
+      fds[nfds].fd = m_InputFd;
+      fds[nfds].events = POLLIN;
+      fds[nfds].revents = 0;
+      nfds++;
+   }
+
+   if (poll(fds, nfds, static_cast<int>(timeoutMs)) <= 0)
+   {
+      return;
+   }
+
+   for (nfds_t i=0; i < nfds; ++i)
+   {
+      if ( (fds[i].fd == m_WakeupFd) && (fds[i].revents & POLLIN) )
+      {
+         // Just reset the counter, the commands are in the queue
+         uint64_t count;
+         if (read(m_WakeupFd, &count, sizeof(count)) != sizeof(count))
+         {
+            // Nothing to do, counter already reset
+         }
+      }
+      if ( (fds[i].fd == m_InputFd) && (fds[i].revents & POLLIN) )
+      {
+         // Read the new input now instead of waiting for the read period
+         lv_task_t *readTask = m_pIndev->driver.read_task;
+         lv_task_set_prio(readTask, LV_TASK_PRIO_MID);
+         lv_task_ready(readTask);
+      }
    }
 }
 
 ///////////////////////////////////////////////////////////////
 
-void NolPiGui::StartPreload()
+void NolPiGui::SuspendIdleInput()
 {
-   if (m_PreloadThread)
+   if ( (m_InputFd == -1) || (m_pIndev == NULL) )
+   {
+      return;
+   }
+
+   // Stop periodic reading of the touchscreen when it's released and
+   // all release processing (e.g. drag throw) is done.
+   // Reading is resumed by WaitForWork() when new input arrives.
+   const lv_indev_proc_t &proc = m_pIndev->proc;
+   if ( (proc.state == LV_INDEV_STATE_REL) &&
+        (proc.types.pointer.drag_in_prog == 0) &&
+        (proc.types.pointer.drag_throw_vect.x == 0) &&
+        (proc.types.pointer.drag_throw_vect.y == 0) )
    {
-      std::lock_guard<std::mutex> guard(m_PreloadMutex);
-      m_PreloadStart = true;
-      m_PreloadCondVar.notify_one();
+      lv_task_set_prio(m_pIndev->driver.read_task, LV_TASK_PRIO_OFF);
    }
 }
 
 ///////////////////////////////////////////////////////////////
 
-void NolPiGui::StopPreload()
+void NolPiGui::Wakeup()
 {
-   if (m_PreloadThread)
+   if (m_WakeupFd != -1)
    {
-      m_PreloadStart = false;
+      uint64_t one = 1;
+      if (write(m_WakeupFd, &one, sizeof(one)) != sizeof(one))
+      {
+         // Counter is already signaled
+      }
    }
 }
 
 ///////////////////////////////////////////////////////////////
 
-void NolPiGui::DisablePreload()
+void NolPiGui::PostCmd(const NolPiGuiCmd &cmd)
 {
-   if (m_PreloadThread)
+   if (m_CmdQueue.Post(cmd))
    {
-      m_PreloadEnable = false;
-      StartPreload();
-      m_PreloadThread->join();
-      delete m_PreloadThread;
+      Wakeup();
+   }
+   else
+   {
+      printf("%s : command queue full\n", __func__);
    }
 }
 
 ///////////////////////////////////////////////////////////////
 
-bool NolPiGui::IsPreloadStarted()
+void NolPiGui::ExecuteCmd(const NolPiGuiCmd &cmd)
 {
-   if (m_PreloadThread)
+   // Executed by the task handler thread only
+   switch (cmd.type)
    {
-      return m_PreloadStart;
+   case NolPiGuiCmd::TEMP_SAMPLES:
+      // Samples are applied by the task, at most once per frame
+      if (m_pTempTask->prio == LV_TASK_PRIO_OFF)
+      {
+         lv_task_set_prio(m_pTempTask, LV_TASK_PRIO_MID);
+      }
+      break;
    }
+}
 
-   return false;
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::StartPreload()
+{
+   // Show Preloader, the steps are run by the preload task
+   lv_obj_set_hidden(m_pStartButton, true);
+   lv_obj_set_hidden(m_pSimulateCheckbox, true);
+   lv_obj_set_hidden(m_pPreload, false);
+   lv_obj_set_hidden(m_pPreloadLabel, false);
+   lv_label_set_text(m_pPreloadLabel, PRELOAD_STEPS[0].name);
+
+   // Restart the spinner animation
+   lv_preload_set_type(m_pPreload, lv_preload_get_type(m_pPreload));
+
+   m_PreloadStep = 0;
+   m_Metrics.PreloadBegin();
+   lv_task_set_prio(m_pPreloadTask, LV_TASK_PRIO_MID);
 }
 
 ///////////////////////////////////////////////////////////////
 
-void NolPiGui::PreloadHandler()
+void NolPiGui::RunPreloadStep()
 {
-   // Create a style for the Preloader
-   static lv_style_t style;
-   lv_style_copy(&style, &lv_style_plain);
-   style.line.width = 10;                          // 10 px thick arc
-   style.line.color = lv_color_hex3(0x258);        // Blueish arc color
-   style.body.border.color = lv_color_hex3(0xBBB); // Gray background color
-   style.body.border.width = 10;
-   style.body.padding.left = 0;
+   if (m_PreloadStep >= NR_PRELOAD_STEPS)
+   {
+      FinishPreload();
+      return;
+   }
 
-   // Create a label
-   lv_obj_t *label1 = lv_label_create(m_pScreenEntry, NULL);
+   const PreloadStep &step = PRELOAD_STEPS[m_PreloadStep];
 
-   // Create a style and font for the label
-   static lv_style_t style_label1;
-   lv_style_copy(&style_label1, &lv_style_plain);
-   style_label1.text.font = &lv_font_roboto_28;
-   style_label1.text.color = LV_COLOR_RED;
-   lv_label_set_style(label1, LV_LABEL_STYLE_MAIN, &style_label1);
-   lv_obj_align(label1, NULL, LV_ALIGN_CENTER, 20, 100);
-   lv_obj_set_hidden(label1, true);
+   m_Metrics.PreloadStepBegin();
+   (this->*step.run)();
+   m_Metrics.PreloadStepEnd(step.name);
 
-   // Executed as thread, until disabled
-   while (m_PreloadEnable)
+   // Show next step, it's drawn while the step runs
+   m_PreloadStep++;
+   if (m_PreloadStep < NR_PRELOAD_STEPS)
    {
-      // Wait for start command, synchronize with caller
-      std::unique_lock<std::mutex> mlock(m_PreloadMutex);
-      m_PreloadCondVar.wait(mlock,
-                            std::bind(&NolPiGui::IsPreloadStarted,
-                            this));
+      lv_label_set_text(m_pPreloadLabel, PRELOAD_STEPS[m_PreloadStep].name);
+   }
+}
 
-      if (not m_PreloadEnable)
-      {
-         break;
-      }
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::FinishPreload()
+{
+   lv_task_set_prio(m_pPreloadTask, LV_TASK_PRIO_OFF);
+
+   lv_obj_set_hidden(m_pStartButton, false);
+   lv_obj_set_hidden(m_pSimulateCheckbox, false);
+   if (!m_Simulate)
+   {
+      SetTemp(IDX_CURRENT_TEMP, DEFAULT_CURRENT_TEMP);
+   }
+
+   // Hide Preloader and open main screen
+   lv_obj_set_hidden(m_pPreloadLabel, true);
+   lv_obj_set_hidden(m_pPreload, true);
+   lv_anim_del(m_pPreload, NULL);
+   OpenMainScreen();
+
+   m_Metrics.PreloadEnd();
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::PreloadMainScreen()
+{
+   AcquireScreen(SCREEN_MAIN);
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::PreloadChartScreen()
+{
+   AcquireScreen(SCREEN_CHART);
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::PreloadLayers()
+{
+   // The static objects are drawn from their layers from the first frame
+   if (m_pScreenMain != NULL)
+   {
+      lv_refr_render_layers(m_pScreenMain);
+   }
+   if (m_pScreenChart != NULL)
+   {
+      lv_refr_render_layers(m_pScreenChart);
+   }
+}
+
+///////////////////////////////////////////////////////////////
+
+lv_obj_t* NolPiGui::AcquireScreen(ScreenId id)
+{
+   const ScreenInfo &info = SCREENS[id];
 
-      // Create a Preloader
-      lv_obj_t *preload = lv_preload_create(m_pScreenEntry, NULL);
-      lv_obj_set_size(preload, 100, 100);
-      lv_obj_align(preload, NULL, LV_ALIGN_CENTER, 0, 0);
-      lv_preload_set_style(preload, LV_PRELOAD_STYLE_MAIN, &style);
-      lv_preload_set_spin_time(preload, 750);
-      lv_preload_set_arc_length(preload, 90);
-
-      // Show Preloader and countdown
-      lv_obj_set_hidden(m_pStartButton, true);
-      lv_obj_set_hidden(m_pSimulateCheckbox, true);
-      lv_obj_set_hidden(label1, false);
-      for (int i=PRELOAD_TIME_S; i > 0 ; --i)
+   EvictScreens(id);
+
+   if (this->*info.screen == NULL)
+   {
+      // Creating a screen loads it to create its objects
+      lv_obj_t *screen = lv_scr_act();
+      (this->*info.create)();
+      lv_scr_load(screen);
+   }
+
+   m_ScreenLastUse[id] = ++m_ScreenUseCount;
+
+   return this->*info.screen;
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::EvictScreens(ScreenId keep)
+{
+   // Make room for 'keep', never destroy the shown screen
+   for (;;)
+   {
+      unsigned int cached = (this->*SCREENS[keep].screen == NULL ? 1 : 0);
+      int lru = -1;
+
+      for (int id=0; id < NR_SCREENS; ++id)
       {
-         lv_label_set_text(label1, std::to_string(i).c_str());
-         std::this_thread::sleep_for(std::chrono::seconds(1));
+         lv_obj_t *screen = this->*SCREENS[id].screen;
+         if (screen == NULL)
+         {
+            continue;
+         }
+         cached++;
+         if ( (id == keep) || (screen == lv_scr_act()) )
+         {
+            continue;
+         }
+         if ( (lru == -1) || (m_ScreenLastUse[id] < m_ScreenLastUse[lru]) )
+         {
+            lru = id;
+         }
       }
-      lv_obj_set_hidden(m_pStartButton, false);
-      lv_obj_set_hidden(m_pSimulateCheckbox, false);
-      if (!m_Simulate)
+
+      lv_mem_monitor_t mon;
+      lv_mem_monitor(&mon);
+
+      if ( (lru == -1) ||
+           ( (cached <= MAX_CACHED_SCREENS) &&
+             (mon.used_pct < SCREEN_EVICT_USED_PCT) ) )
       {
-         SetCurrentTemp(DEFAULT_CURRENT_TEMP);
+         break;
       }
-      lv_obj_set_hidden(label1, true);
 
-      // Destroy Preloader and open main screen
-      lv_obj_del(preload);
-      StopPreload();
-      OpenMainScreen();
+      (this->*SCREENS[lru].destroy)();
+   }
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::SuspendScreen(lv_obj_t *screen)
+{
+   // Stop animations of a screen that is no longer shown
+   if ( (screen != NULL) && (screen == m_pScreenImage) )
+   {
+      lv_anim_del(m_pImageCustomImage, (lv_anim_exec_xcb_t)CustomImageAnimator);
+   }
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::ResumeScreen(lv_obj_t *screen)
+{
+   // Start animations of a screen that is shown
+   if ( (screen != NULL) && (screen == m_pScreenImage) )
+   {
+      lv_anim_t a;
+      lv_anim_init(&a);
+      lv_anim_set_time(&a, 4000, 0);
+      lv_anim_set_values(&a, ANIM_X_MIN, ANIM_X_MAX);
+      lv_anim_set_path_cb(&a, lv_anim_path_linear);
+      lv_anim_set_playback(&a, 100);
+      lv_anim_set_repeat(&a, 100);
+      lv_anim_set_exec_cb(&a, m_pImageCustomImage, (lv_anim_exec_xcb_t)CustomImageAnimator);
+      lv_anim_create(&a);
    }
 }
 
@@ -529,6 +912,7 @@ void NolPiGui::CreateEntryScreen()
    lv_obj_t *label1 = lv_label_create(lv_scr_act(), NULL);
    lv_label_set_text(label1, "NOLPI LittlevGL Demo");
    lv_obj_align(label1, NULL, LV_ALIGN_IN_TOP_MID, 0, 20);
+   lv_obj_set_layer_cache(label1, true); // Static, draw from a cached layer
 
    // Create a start button
    m_pStartButton = lv_btn_create(lv_scr_act(), NULL);
@@ -551,6 +935,40 @@ void NolPiGui::CreateEntryScreen()
    // Define a handler to the checkbox
    lv_obj_set_user_data(m_pSimulateCheckbox, static_cast<lv_obj_user_data_t>(this));
    lv_obj_set_event_cb(m_pSimulateCheckbox, EventCbEntryScreenCheckbox);
+
+   ///////////////////////////////////////////////////////////////
+
+   // Create a style for the Preloader
+   static lv_style_t style;
+   lv_style_copy(&style, &lv_style_plain);
+   style.line.width = 10;                          // 10 px thick arc
+   style.line.color = lv_color_hex3(0x258);        // Blueish arc color
+   style.body.border.color = lv_color_hex3(0xBBB); // Gray background color
+   style.body.border.width = 10;
+   style.body.padding.left = 0;
+
+   // Create a Preloader, shown while preloading
+   m_pPreload = lv_preload_create(lv_scr_act(), NULL);
+   lv_obj_set_size(m_pPreload, 100, 100);
+   lv_obj_align(m_pPreload, NULL, LV_ALIGN_CENTER, 0, 0);
+   lv_preload_set_style(m_pPreload, LV_PRELOAD_STYLE_MAIN, &style);
+   lv_preload_set_spin_time(m_pPreload, 750);
+   lv_preload_set_arc_length(m_pPreload, 90);
+   lv_obj_set_hidden(m_pPreload, true);
+   lv_anim_del(m_pPreload, NULL); // Spins only while shown
+
+   // Create a label for the preload step
+   m_pPreloadLabel = lv_label_create(lv_scr_act(), NULL);
+
+   // Create a style and font for the label
+   static lv_style_t style_label3;
+   lv_style_copy(&style_label3, &lv_style_plain);
+   style_label3.text.font = &lv_font_roboto_28;
+   style_label3.text.color = LV_COLOR_RED;
+   lv_label_set_style(m_pPreloadLabel, LV_LABEL_STYLE_MAIN, &style_label3);
+   lv_obj_align(m_pPreloadLabel, NULL, LV_ALIGN_CENTER, 0, 100);
+   lv_obj_set_auto_realign(m_pPreloadLabel, true); // Keep centered for any step name
+   lv_obj_set_hidden(m_pPreloadLabel, true);
 }
 
 ///////////////////////////////////////////////////////////////
@@ -589,6 +1007,7 @@ void NolPiGui::CreateMainScreen()
    style_label1.text.color = LV_COLOR_YELLOW;
    lv_label_set_style(label1, LV_LABEL_STYLE_MAIN, &style_label1);
    lv_obj_align(label1, NULL, LV_ALIGN_CENTER, 0, -140);
+   lv_obj_set_layer_cache(label1, true); // Static, draw from a cached layer
 
    ///////////////////////////////////////////////////////////////
 
@@ -606,6 +1025,10 @@ void NolPiGui::CreateMainScreen()
    lv_label_set_text(label22, LV_SYMBOL_NEXT);
    lv_obj_align(m_pMainNextBut, NULL, LV_ALIGN_IN_TOP_RIGHT, -10, 10);
 
+   // Static unless pressed, draw from cached layers
+   lv_obj_set_layer_cache(m_pMainPrevBut, true);
+   lv_obj_set_layer_cache(m_pMainNextBut, true);
+
    // Define a handler to the buttons
    lv_obj_set_user_data(m_pMainPrevBut, static_cast<lv_obj_user_data_t>(this));
    lv_obj_set_user_data(m_pMainNextBut, static_cast<lv_obj_user_data_t>(this));
@@ -680,7 +1103,7 @@ void NolPiGui::CreateMainScreen()
    lv_slider_set_range(m_pWarningSlider, 0, MAX_TEMP);
 
    // Set initial value
-   lv_slider_set_value(m_pWarningSlider, DEFAULT_WARNING_TEMP, LV_ANIM_OFF);
+   lv_slider_set_value(m_pWarningSlider, m_WarningTemp, LV_ANIM_OFF);
 
    // Define a handler to the slider
    lv_obj_set_user_data(m_pWarningSlider, static_cast<lv_obj_user_data_t>(this));
@@ -708,9 +1131,10 @@ void NolPiGui::CreateMainScreen()
 
    ///////////////////////////////////////////////////////////////
 
-   // Set initial temperature values
-   SetCurrentTemp(DEFAULT_CURRENT_TEMP);
-   SetWarningTemp(DEFAULT_WARNING_TEMP);
+   // Show the temperatures, this screen may have been destroyed before
+   lv_gauge_set_value(m_pTempGauge, IDX_CURRENT_TEMP, m_CurrentTemp);
+   lv_gauge_set_value(m_pTempGauge, IDX_WARNING_TEMP, m_WarningTemp);
+   UpdateWarningLED(m_CurrentTemp);
 }
 
 ///////////////////////////////////////////////////////////////
@@ -753,6 +1177,10 @@ void NolPiGui::CreateChartScreen()
    lv_label_set_style(label2, LV_LABEL_STYLE_MAIN, &style_label2);
    lv_obj_align(label2, NULL, LV_ALIGN_IN_TOP_MID, 0, 30);
 
+   // Static, draw from cached layers
+   lv_obj_set_layer_cache(label1, true);
+   lv_obj_set_layer_cache(label2, true);
+
    ///////////////////////////////////////////////////////////////
 
    // Create a left (previous) button
@@ -769,6 +1197,10 @@ void NolPiGui::CreateChartScreen()
    lv_label_set_text(label32, LV_SYMBOL_NEXT);
    lv_obj_align(m_pChartNextBut, NULL, LV_ALIGN_IN_TOP_RIGHT, -10, 10);
 
+   // Static unless pressed, draw from cached layers
+   lv_obj_set_layer_cache(m_pChartPrevBut, true);
+   lv_obj_set_layer_cache(m_pChartNextBut, true);
+
    // Define a handler to the button
    lv_obj_set_user_data(m_pChartPrevBut, static_cast<lv_obj_user_data_t>(this));
    lv_obj_set_user_data(m_pChartNextBut, static_cast<lv_obj_user_data_t>(this));
@@ -800,9 +1232,17 @@ void NolPiGui::CreateChartScreen()
                              LV_CHART_AXIS_DRAW_LAST_TICK);
    lv_chart_set_margin(m_pTempChart, 50);
 
-   // Add two data series
+   // Add the data series, the min/max envelope first to draw it below
+   m_pMinSerie     = lv_chart_add_series(m_pTempChart, LV_COLOR_SILVER);
+   m_pMaxSerie     = lv_chart_add_series(m_pTempChart, LV_COLOR_SILVER);
    m_pCurrentSerie = lv_chart_add_series(m_pTempChart, LV_COLOR_BLUE);
    m_pWarningSerie = lv_chart_add_series(m_pTempChart, LV_COLOR_ORANGE);
+
+   // Show the history, this screen may have been destroyed before
+   lv_chart_set_points(m_pTempChart, m_pMinSerie, m_MinHistory);
+   lv_chart_set_points(m_pTempChart, m_pMaxSerie, m_MaxHistory);
+   lv_chart_set_points(m_pTempChart, m_pCurrentSerie, m_CurrentHistory);
+   lv_chart_set_points(m_pTempChart, m_pWarningSerie, m_WarningHistory);
 }
 
 ///////////////////////////////////////////////////////////////
@@ -813,7 +1253,7 @@ void NolPiGui::CreateImageScreen()
 
    // Create screen
    m_pScreenImage = lv_obj_create(NULL, NULL);
-   if (m_pScreenChart == NULL)
+   if (m_pScreenImage == NULL)
    {
       printf("%s : create image screen failed\n", __func__);
    }
@@ -843,16 +1283,45 @@ void NolPiGui::CreateImageScreen()
    lv_obj_set_pos(m_pImageCustomImage, ANIM_X_MIN, ANIM_Y_START);
    lv_obj_set_user_data(m_pImageCustomImage, static_cast<lv_obj_user_data_t>(this));
 
-   // Create an animation for the image
-   lv_anim_t a;
-   lv_anim_init(&a);
-   lv_anim_set_time(&a, 4000, 0);
-   lv_anim_set_values(&a, ANIM_X_MIN, ANIM_X_MAX);
-   lv_anim_set_path_cb(&a, lv_anim_path_linear);
-   lv_anim_set_playback(&a, 100);
-   lv_anim_set_repeat(&a, 100);
-   lv_anim_set_exec_cb(&a, m_pImageCustomImage, (lv_anim_exec_xcb_t)CustomImageAnimator);
-   lv_anim_create(&a);
+   // The animation runs only while the screen is shown, see ResumeScreen()
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::DestroyMainScreen()
+{
+   lv_obj_del(m_pScreenMain);
+   m_pScreenMain    = nullptr;
+   m_pMainPrevBut   = nullptr;
+   m_pMainNextBut   = nullptr;
+   m_pTempGauge     = nullptr;
+   m_pWarningSlider = nullptr;
+   m_pWarningLED    = nullptr;
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::DestroyChartScreen()
+{
+   lv_obj_del(m_pScreenChart);
+   m_pScreenChart  = nullptr;
+   m_pChartPrevBut = nullptr;
+   m_pChartNextBut = nullptr;
+   m_pTempChart    = nullptr;
+   m_pCurrentSerie = nullptr;
+   m_pWarningSerie = nullptr;
+   m_pMinSerie     = nullptr;
+   m_pMaxSerie     = nullptr;
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::DestroyImageScreen()
+{
+   lv_obj_del(m_pScreenImage);
+   m_pScreenImage       = nullptr;
+   m_pImagePrevBut      = nullptr;
+   m_pImageCustomImage  = nullptr;
 }
 
 ///////////////////////////////////////////////////////////////
@@ -866,21 +1335,21 @@ void NolPiGui::OpenEntryScreen()
 
 void NolPiGui::OpenMainScreen()
 {
-   RedrawScreen(m_pScreenMain);
+   RedrawScreen(AcquireScreen(SCREEN_MAIN));
 }
 
 ///////////////////////////////////////////////////////////////
 
 void NolPiGui::OpenChartScreen()
 {
-   RedrawScreen(m_pScreenChart);
+   RedrawScreen(AcquireScreen(SCREEN_CHART));
 }
 
 ///////////////////////////////////////////////////////////////
 
 void NolPiGui::OpenImageScreen()
 {
-   RedrawScreen(m_pScreenImage);
+   RedrawScreen(AcquireScreen(SCREEN_IMAGE));
 }
 
 ///////////////////////////////////////////////////////////////
@@ -889,14 +1358,17 @@ void NolPiGui::RedrawScreen(lv_obj_t *screen)
 {
    if (screen != NULL)
    {
-      if (!PcEnv::enabled)
-      {
-         // hack to get around fbcon cursor blink
-         system("/bin/echo 0 > /sys/class/graphics/fbcon/cursor_blink");
-      }
+      lv_obj_t *oldScreen = lv_scr_act();
 
       lv_scr_load(screen);
       lv_obj_invalidate(screen);
+
+      // Only the shown screen runs its animations
+      if (oldScreen != screen)
+      {
+         SuspendScreen(oldScreen);
+         ResumeScreen(screen);
+      }
    }
 }
 
@@ -904,30 +1376,164 @@ void NolPiGui::RedrawScreen(lv_obj_t *screen)
 
 void NolPiGui::SetTemp(int idx, int value)
 {
-   value = (value > MAX_TEMP ? MAX_TEMP : value);
-   value = (value < 0 ? 0 : value);
+   value = ClampTemp(value);
 
    if (idx == IDX_WARNING_TEMP)
    {
       m_WarningTemp = value; 
+
+      // Keep the history, only the newest point follows the slider
+      SetNewestChartPoint(IDX_WARNING_TEMP, m_WarningTemp);
    }
 
    if (idx == IDX_CURRENT_TEMP)
    {
-      if (m_pTempChart && m_pCurrentSerie)
+      m_CurrentTemp = value;
+      ShiftChart(value, value, value);
+
+      // Next sample starts a new chart point
+      m_ChartColumnValid = false;
+   }
+
+   if (m_pTempGauge != NULL)
+   {
+      lv_gauge_set_value(m_pTempGauge, idx, value);
+   }
+
+   UpdateWarningLED(m_CurrentTemp);
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::ApplyTempSamples()
+{
+   if (m_TempIngest.Coalesce(m_TempBatch) == 0)
+   {
+      // Idle until the sensor posts again
+      lv_task_set_prio(m_pTempTask, LV_TASK_PRIO_OFF);
+      return;
+   }
+
+   // One chart point for each column, the newest point is updated
+   // in place until its column is closed. The envelope shows the lowest
+   // and highest sample of the column.
+   for (const NolPiTempIngest::Column &column : m_TempBatch.columns)
+   {
+      int value = ClampTemp(column.last);
+      int min = ClampTemp(column.min);
+      int max = ClampTemp(column.max);
+
+      if (m_ChartColumnValid && (column.index == m_ChartColumn))
+      {
+         SetNewestChartPoint(IDX_CURRENT_TEMP, value);
+         SetNewestChartPoint(IDX_MIN_TEMP, min);
+         SetNewestChartPoint(IDX_MAX_TEMP, max);
+         continue;
+      }
+
+      // Columns without samples are empty points, to keep the time axis
+      if (m_ChartColumnValid && (column.index > m_ChartColumn))
       {
-         lv_chart_set_next(m_pTempChart, m_pCurrentSerie, value);
+         std::uint32_t empty = column.index - m_ChartColumn - 1;
+         empty = (empty > NR_TEMP_POINTS ? NR_TEMP_POINTS : empty);
+         for (std::uint32_t i = 0; i < empty; ++i)
+         {
+            ShiftChart(LV_CHART_POINT_DEF, LV_CHART_POINT_DEF, LV_CHART_POINT_DEF);
+         }
       }
+
+      ShiftChart(value, min, max);
+      m_ChartColumn      = column.index;
+      m_ChartColumnValid = true;
    }
 
-   if (m_pTempChart && m_pWarningSerie)
+   // The gauge shows the newest sample, the LED any sample above warning
+   m_CurrentTemp = ClampTemp(m_TempBatch.last);
+   if (m_pTempGauge != NULL)
    {
+      lv_gauge_set_value(m_pTempGauge, IDX_CURRENT_TEMP, m_CurrentTemp);
+   }
+
+   UpdateWarningLED(m_TempBatch.max);
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::ShiftChart(int value, int min, int max)
+{
+   // The history is kept also when the chart screen doesn't exist
+   memmove(&m_CurrentHistory[0], &m_CurrentHistory[1],
+           (NR_TEMP_POINTS - 1) * sizeof(lv_coord_t));
+   memmove(&m_WarningHistory[0], &m_WarningHistory[1],
+           (NR_TEMP_POINTS - 1) * sizeof(lv_coord_t));
+   memmove(&m_MinHistory[0], &m_MinHistory[1],
+           (NR_TEMP_POINTS - 1) * sizeof(lv_coord_t));
+   memmove(&m_MaxHistory[0], &m_MaxHistory[1],
+           (NR_TEMP_POINTS - 1) * sizeof(lv_coord_t));
+   m_CurrentHistory[NR_TEMP_POINTS - 1] = value;
+   m_WarningHistory[NR_TEMP_POINTS - 1] = m_WarningTemp;
+   m_MinHistory[NR_TEMP_POINTS - 1]     = min;
+   m_MaxHistory[NR_TEMP_POINTS - 1]     = max;
+
+   if (m_pTempChart != NULL)
+   {
+      lv_chart_set_next(m_pTempChart, m_pMinSerie, min);
+      lv_chart_set_next(m_pTempChart, m_pMaxSerie, max);
+      lv_chart_set_next(m_pTempChart, m_pCurrentSerie, value);
       lv_chart_set_next(m_pTempChart, m_pWarningSerie, m_WarningTemp);
    }
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::SetNewestChartPoint(int idx, int value)
+{
+   lv_coord_t *history = m_CurrentHistory;
+   lv_chart_series_t *serie = m_pCurrentSerie;
+   if (idx == IDX_WARNING_TEMP)
+   {
+      history = m_WarningHistory;
+      serie = m_pWarningSerie;
+   }
+   else if (idx == IDX_MIN_TEMP)
+   {
+      history = m_MinHistory;
+      serie = m_pMinSerie;
+   }
+   else if (idx == IDX_MAX_TEMP)
+   {
+      history = m_MaxHistory;
+      serie = m_pMaxSerie;
+   }
+
+   history[NR_TEMP_POINTS - 1] = value;
+
+   if ( (m_pTempChart == NULL) || (serie == NULL) )
+   {
+      return;
+   }
 
-   lv_gauge_set_value(m_pTempGauge, idx, value);
+   // In shift mode the newest point is just before the start point
+   uint16_t pointCnt = lv_chart_get_point_cnt(m_pTempChart);
+   uint16_t newest = (serie->start_point + pointCnt - 1) % pointCnt;
 
-   if (lv_gauge_get_value(m_pTempGauge, IDX_CURRENT_TEMP) > m_WarningTemp)
+   if (serie->points[newest] != value)
+   {
+      serie->points[newest] = value;
+      lv_chart_refresh(m_pTempChart);
+   }
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::UpdateWarningLED(int temp)
+{
+   if (m_pWarningLED == NULL)
+   {
+      return;
+   }
+
+   if (temp > m_WarningTemp)
    {
       lv_led_on(m_pWarningLED);
    }
@@ -939,6 +1545,69 @@ void NolPiGui::SetTemp(int idx, int value)
 
 ///////////////////////////////////////////////////////////////
 
+int NolPiGui::ClampTemp(int value)
+{
+   // The range of the gauge, slider and chart
+   value = (value > MAX_TEMP ? MAX_TEMP : value);
+   return (value < 0 ? 0 : value);
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::UpdateOverlay()
+{
+   if (!m_Metrics.OverlayRequested())
+   {
+      if (m_pOverlayLabel != NULL)
+      {
+         lv_obj_del(m_pOverlayLabel);
+         m_pOverlayLabel = nullptr;
+      }
+      return;
+   }
+
+   if (m_pOverlayLabel == NULL)
+   {
+      // Create a style with a dark, translucent background
+      static lv_style_t style_overlay;
+      lv_style_copy(&style_overlay, &lv_style_plain);
+      style_overlay.body.main_color = LV_COLOR_BLACK;
+      style_overlay.body.grad_color = LV_COLOR_BLACK;
+      style_overlay.body.opa = LV_OPA_60;
+      style_overlay.text.color = LV_COLOR_WHITE;
+
+      // Shown on the top layer, above all screens
+      m_pOverlayLabel = lv_label_create(lv_layer_top(), NULL);
+      lv_label_set_style(m_pOverlayLabel, LV_LABEL_STYLE_MAIN, &style_overlay);
+      lv_label_set_body_draw(m_pOverlayLabel, true);
+      lv_obj_align(m_pOverlayLabel, NULL, LV_ALIGN_IN_BOTTOM_LEFT, 5, -5);
+      lv_obj_set_auto_realign(m_pOverlayLabel, true);
+   }
+
+   // Show the averages since last update
+   const NolPiMetricsStats &stats = m_Metrics.GetStats();
+   auto avg = [](const NolPiHistogram &cur, const NolPiHistogram &prev)
+   {
+      std::uint64_t count = cur.count - prev.count;
+      return static_cast<unsigned long>(count > 0 ? (cur.sum - prev.sum) / count : 0);
+   };
+
+   unsigned long frames = static_cast<unsigned long>(stats.frames - m_OverlayStats.frames);
+   char text[96];
+   snprintf(text, sizeof(text),
+            "%lu fps  render %lu us  flush %lu us\n"
+            "%lu px  touch %lu us",
+            frames * 1000 / OVERLAY_PERIOD_MS,
+            avg(stats.renderUs, m_OverlayStats.renderUs),
+            avg(stats.flushUs, m_OverlayStats.flushUs),
+            avg(stats.pixels, m_OverlayStats.pixels),
+            avg(stats.latencyUs, m_OverlayStats.latencyUs));
+   lv_label_set_text(m_pOverlayLabel, text);
+   m_OverlayStats = stats;
+}
+
+///////////////////////////////////////////////////////////////
+
 void NolPiGui::EventCbEntryScreenButton(lv_obj_t *obj, lv_event_t event)
 {
    if (obj)
@@ -1082,6 +1751,141 @@ void NolPiGui::EventCbImageScreenButton(lv_obj_t *obj, lv_event_t event)
 
 ///////////////////////////////////////////////////////////////
 
+void NolPiGui::DisplayFlush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *colors)
+{
+   NolPiGui *instance = static_cast<NolPiGui *>(drv->user_data);
+
+   instance->m_Metrics.FlushBegin();
+   instance->m_DisplayFlush(drv, area, colors);
+   instance->m_Metrics.FlushEnd();
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::DisplayMonitor(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+   NolPiGui *instance = static_cast<NolPiGui *>(drv->user_data);
+
+   // Merges avoided redrawing the whole screen when too many areas were dirty
+   lv_disp_t *disp = lv_refr_get_disp_refreshing();
+   uint32_t drawPx;
+   uint32_t cullPx;
+   lv_disp_get_overdraw(disp, &drawPx, &cullPx);
+   uint32_t late;
+   uint32_t dropped;
+   lv_disp_get_frame_stats(disp, &late, &dropped);
+   instance->m_Metrics.SetQueueStats(instance->m_CmdQueue.GetStats(),
+                                     instance->m_TempIngest.GetStats());
+   instance->m_Metrics.FrameEnd(px, lv_disp_get_inv_merge_cnt(disp), drawPx, cullPx,
+                                late, dropped);
+   if (instance->m_DisplayMonitor)
+   {
+      instance->m_DisplayMonitor(drv, time, px);
+   }
+}
+
+///////////////////////////////////////////////////////////////
+
+bool NolPiGui::DisplayVsync(lv_disp_drv_t *drv)
+{
+   NolPiGui *instance = static_cast<NolPiGui *>(drv->user_data);
+
+   bool waited = instance->m_DisplayVsync(drv);
+
+   // Waiting for the display is not rendering
+   instance->m_Metrics.FrameBegin();
+
+   return waited;
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::DisplayWait(lv_disp_drv_t *drv)
+{
+   NolPiGui *instance = static_cast<NolPiGui *>(drv->user_data);
+
+   // Waiting for the flush thread is not rendering
+   instance->m_Metrics.WaitBegin();
+   instance->m_DisplayWait(drv);
+   instance->m_Metrics.WaitEnd();
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::DisplayFlushReady(lv_disp_drv_t *drv)
+{
+   NolPiGui *instance = static_cast<NolPiGui *>(drv->user_data);
+
+   instance->m_Metrics.FlushReady();
+}
+
+///////////////////////////////////////////////////////////////
+
+bool NolPiGui::InputRead(lv_indev_drv_t *drv, lv_indev_data_t *data)
+{
+   NolPiGui *instance = static_cast<NolPiGui *>(drv->user_data);
+   NolPiSessionLog *log = instance->m_pSessionLog;
+
+   bool more;
+   if ( log && log->Replaying() )
+   {
+      more = log->ReplayInput(*data);
+   }
+   else
+   {
+      more = instance->m_InputRead(drv, data);
+      if ( log && log->Recording() )
+      {
+         log->RecordInput(*data);
+      }
+   }
+
+   instance->m_Metrics.InputRead(data->state == LV_INDEV_STATE_PR);
+
+   return more;
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::RefreshTask(lv_task_t *task)
+{
+   // The task belongs to the display, user data is the display
+   lv_disp_t *disp = static_cast<lv_disp_t *>(task->user_data);
+   NolPiGui *instance = static_cast<NolPiGui *>(disp->driver.user_data);
+
+   instance->m_Metrics.FrameBegin();
+   lv_disp_refr_task(task);
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::OverlayTask(lv_task_t *task)
+{
+   NolPiGui *instance = static_cast<NolPiGui *>(task->user_data);
+
+   instance->UpdateOverlay();
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::TempIngestTask(lv_task_t *task)
+{
+   NolPiGui *instance = static_cast<NolPiGui *>(task->user_data);
+
+   instance->ApplyTempSamples();
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGui::PreloadTask(lv_task_t *task)
+{
+   NolPiGui *instance = static_cast<NolPiGui *>(task->user_data);
+
+   instance->RunPreloadStep();
+}
+
+///////////////////////////////////////////////////////////////
+
 void NolPiGui::CustomImageAnimator(void *obj, lv_anim_value_t value)
 {
    // Old position
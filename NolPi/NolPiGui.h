@@ -2,17 +2,20 @@
 #define _NOLPI_GUI_H_
 
 #include <thread>
-#include <mutex>
-#include <condition_variable>
+#include <atomic>
 
 #include "LittlevGL/lvgl/lvgl.h"
+#include "NolPi/NolPiGuiCmdQueue.h"
+#include "NolPi/NolPiTempIngest.h"
+#include "NolPi/NolPiSessionLog.h"
+#include "NolPi/NolPiMetrics.h"
 
 class NolPiGui
 {
 public:
    static constexpr int MAX_TEMP = 35;
 
-   NolPiGui();
+   explicit NolPiGui(NolPiSessionLog *log = nullptr);
    ~NolPiGui();
 
    void DummyApi();
@@ -22,7 +25,7 @@ public:
    void StartChart();            // Public to be callable from static callback
    void StartImage();            // Public to be callable from static callback
 
-   void SetCurrentTemp(int value);
+   void SetCurrentTemp(int value); // Thread safe, single sensor thread
    void SetWarningTemp(int value); // Public to be callable from static callback
 
    bool SimulateTempActive();
@@ -37,15 +40,60 @@ public:
    lv_obj_t* GetImageCustomImage();  // Public to be callable from static animator
 
 private:
-   // Periodic threads for LittlevGL
-   bool         m_RunThreads{true};
-   std::thread *m_TickHandlerThread{nullptr};
+   // Time covered by each point in the temperature chart
+   static constexpr unsigned int TEMP_COLUMN_MS = 1000;
+   static constexpr int NR_TEMP_POINTS = 20;
+
+   // Screens other than the entry screen are created on demand
+   enum ScreenId
+   {
+      SCREEN_MAIN,
+      SCREEN_CHART,
+      SCREEN_IMAGE,
+      NR_SCREENS
+   };
+
+   // Thread for LittlevGL
+   std::atomic<bool> m_RunThreads{true};
    std::thread *m_TaskHandlerThread{nullptr};
 
+   // Event sources the task handler thread waits for when idle
+   int         m_WakeupFd{-1}; // Signaled when commands are posted
+   int         m_InputFd{-1};  // Input device, -1 if it can't be waited for
+   lv_indev_t *m_pIndev{nullptr};
+
+   // Input device driver read function, wrapped to record or replay input
+   bool (*m_InputRead)(lv_indev_drv_t *drv, lv_indev_data_t *data){nullptr};
+
+   // Session being recorded or replayed, nullptr if none
+   NolPiSessionLog *m_pSessionLog{nullptr};
+
+   // Display driver functions, wrapped to measure frames
+   void (*m_DisplayFlush)(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *colors){nullptr};
+   void (*m_DisplayMonitor)(lv_disp_drv_t *drv, uint32_t time, uint32_t px){nullptr};
+   bool (*m_DisplayVsync)(lv_disp_drv_t *drv){nullptr};
+   void (*m_DisplayWait)(lv_disp_drv_t *drv){nullptr};
+
+   // Frame time and input latency, optionally shown on top of all screens
+   NolPiMetrics       m_Metrics;
+   NolPiMetricsStats  m_OverlayStats{};
+   lv_obj_t          *m_pOverlayLabel{nullptr};
+   lv_task_t         *m_pOverlayTask{nullptr};
+
    // LittlevGL display buffer
-   lv_color_t    *m_pDrawBuffer{nullptr};
+   static constexpr int DRAW_BUFFER_ROWS = LV_VER_RES_MAX / 4; // Framebuffer, two buffers
+   lv_color_t    *m_pDrawBuffer{nullptr}; // Not used if rendering into framebuffer
+   lv_color_t    *m_pDiffBuffer{nullptr}; // Last flushed frame, only changes are flushed
    lv_disp_buf_t  m_DisplayBuffer;
 
+   // Commands from other threads, executed by the task handler thread
+   NolPiGuiCmdQueue m_CmdQueue;
+
+   // Temperature samples from the sensor thread, applied once per frame
+   NolPiTempIngest        m_TempIngest{TEMP_COLUMN_MS};
+   NolPiTempIngest::Batch m_TempBatch;
+   lv_task_t             *m_pTempTask{nullptr};
+
    // LittlevGL screens
    lv_obj_t *m_pScreenTop{nullptr};
    lv_obj_t *m_pScreenEntry{nullptr};
@@ -53,17 +101,37 @@ private:
    lv_obj_t *m_pScreenChart{nullptr};
    lv_obj_t *m_pScreenImage{nullptr};
 
+   // Cache of the screens created on demand, the least recently used
+   // is destroyed when too many are created or LittlevGL is short of memory.
+   struct ScreenInfo
+   {
+      lv_obj_t *NolPiGui::*screen;
+      void (NolPiGui::*create)();
+      void (NolPiGui::*destroy)();
+   };
+   static const ScreenInfo SCREENS[NR_SCREENS];
+
+   unsigned int m_ScreenLastUse[NR_SCREENS]{};
+   unsigned int m_ScreenUseCount{0};
+
    // Graphical objects in entry screen
    lv_obj_t *m_pStartButton{nullptr};
    lv_obj_t *m_pSimulateCheckbox{nullptr};
-   bool      m_Simulate{false};
-
-   // The preloader
-   std::mutex               m_PreloadMutex;
-   std::condition_variable  m_PreloadCondVar;
-   bool                     m_PreloadStart{false};
-   bool                     m_PreloadEnable{true};
-   std::thread             *m_PreloadThread{nullptr};
+   std::atomic<bool> m_Simulate{false};
+
+   // The preloader, runs one preload step each time its task runs
+   struct PreloadStep
+   {
+      const char *name;
+      void (NolPiGui::*run)();
+   };
+   static const PreloadStep PRELOAD_STEPS[];
+   static const unsigned int NR_PRELOAD_STEPS;
+
+   lv_obj_t                              *m_pPreload{nullptr};
+   lv_obj_t                              *m_pPreloadLabel{nullptr};
+   lv_task_t                             *m_pPreloadTask{nullptr};
+   unsigned int                           m_PreloadStep{0};
 
    // The navigation buttons in main screen
    lv_obj_t *m_pMainPrevBut{nullptr};
@@ -76,6 +144,7 @@ private:
    lv_obj_t *m_pWarningSlider{nullptr};
    lv_obj_t *m_pWarningLED{nullptr};
    int       m_WarningTemp{0};
+   int       m_CurrentTemp{0};
 
    // The navigation buttons in chart screen
    lv_obj_t *m_pChartPrevBut{nullptr};
@@ -85,6 +154,16 @@ private:
    lv_obj_t          *m_pTempChart{nullptr};
    lv_chart_series_t *m_pCurrentSerie{nullptr};
    lv_chart_series_t *m_pWarningSerie{nullptr};
+   lv_chart_series_t *m_pMinSerie{nullptr};
+   lv_chart_series_t *m_pMaxSerie{nullptr};
+   std::uint32_t      m_ChartColumn{0};
+   bool               m_ChartColumnValid{false};
+
+   // Chart history, oldest first. Kept when the chart screen is destroyed.
+   lv_coord_t m_CurrentHistory[NR_TEMP_POINTS];
+   lv_coord_t m_WarningHistory[NR_TEMP_POINTS];
+   lv_coord_t m_MinHistory[NR_TEMP_POINTS];
+   lv_coord_t m_MaxHistory[NR_TEMP_POINTS];
 
    // The navigation buttons in image screen
    lv_obj_t *m_pImagePrevBut{nullptr};
@@ -99,21 +178,40 @@ private:
    void CreateGUI();
    void DestroyGUI();
 
+   void StartThreads();
+   void StopThreads();
+
    void SetSchedFifoPriority(int prio);
-   void TickHandler();
    void TaskHandler();
 
+   void WaitForWork(uint32_t timeoutMs);
+   void SuspendIdleInput();
+   void Wakeup();
+
+   void PostCmd(const NolPiGuiCmd &cmd);
+   void ExecuteCmd(const NolPiGuiCmd &cmd);
+
    void StartPreload();
-   void StopPreload();
-   void DisablePreload();
-   bool IsPreloadStarted();
-   void PreloadHandler();
+   void RunPreloadStep();
+   void FinishPreload();
+   void PreloadMainScreen();
+   void PreloadChartScreen();
+   void PreloadLayers();
+
+   lv_obj_t* AcquireScreen(ScreenId id);
+   void EvictScreens(ScreenId keep);
+   void SuspendScreen(lv_obj_t *screen);
+   void ResumeScreen(lv_obj_t *screen);
 
    void CreateEntryScreen();
    void CreateMainScreen();
    void CreateChartScreen();
    void CreateImageScreen();
 
+   void DestroyMainScreen();
+   void DestroyChartScreen();
+   void DestroyImageScreen();
+
    void OpenEntryScreen();
    void OpenMainScreen();
    void OpenChartScreen();
@@ -122,6 +220,13 @@ private:
    void RedrawScreen(lv_obj_t *screen);
 
    void SetTemp(int idx, int value);
+   void ApplyTempSamples();
+   void ShiftChart(int value, int min, int max);
+   void SetNewestChartPoint(int idx, int value);
+   void UpdateWarningLED(int temp);
+   static int ClampTemp(int value);
+
+   void UpdateOverlay();
 
    // Event callbacks (must be static)
    static void EventCbEntryScreenButton(lv_obj_t *obj, lv_event_t event);
@@ -134,6 +239,20 @@ private:
 
    static void EventCbImageScreenButton(lv_obj_t *obj, lv_event_t event);
 
+   // Display and input device driver callbacks (must be static)
+   static void DisplayFlush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *colors);
+   static void DisplayMonitor(lv_disp_drv_t *drv, uint32_t time, uint32_t px);
+   static bool DisplayVsync(lv_disp_drv_t *drv);
+   static void DisplayWait(lv_disp_drv_t *drv);
+   static void DisplayFlushReady(lv_disp_drv_t *drv);
+   static bool InputRead(lv_indev_drv_t *drv, lv_indev_data_t *data);
+
+   // LittlevGL task callbacks (must be static)
+   static void TempIngestTask(lv_task_t *task);
+   static void PreloadTask(lv_task_t *task);
+   static void RefreshTask(lv_task_t *task);
+   static void OverlayTask(lv_task_t *task);
+
    // Custom animation function (must be static)
    static void CustomImageAnimator(void *obj, lv_anim_value_t value); 
 };
@@ -0,0 +1,155 @@
+#include "NolPi/NolPiGuiCmdQueue.h"
+
+////////////////////////////////////////////////////////////////////////////
+//               Public member functions
+////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+
+NolPiGuiCmdQueue::NolPiGuiCmdQueue()
+{
+   static_assert((CAPACITY & (CAPACITY - 1)) == 0,
+                 "CAPACITY must be a power of two");
+
+   // Each cell holds the sequence number of the position it is free for
+   for (unsigned int i=0; i < CAPACITY; ++i)
+   {
+      m_Cells[i].seq.store(i, std::memory_order_relaxed);
+   }
+}
+
+////////////////////////////////////////////////////////////////
+
+NolPiGuiCmdQueue::~NolPiGuiCmdQueue()
+{
+}
+
+////////////////////////////////////////////////////////////////
+
+bool NolPiGuiCmdQueue::Post(const NolPiGuiCmd &cmd)
+{
+   Cell *cell;
+   unsigned int pos = m_EnqueuePos.load(std::memory_order_relaxed);
+
+   // Claim a cell, retry if another producer got there first
+   for (;;)
+   {
+      cell = &m_Cells[pos & (CAPACITY - 1)];
+      unsigned int seq = cell->seq.load(std::memory_order_acquire);
+      int diff = static_cast<int>(seq - pos);
+
+      if (diff == 0)
+      {
+         if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1,
+                                                std::memory_order_relaxed))
+         {
+            break;
+         }
+      }
+      else if (diff < 0)
+      {
+         // Consumer has not released this cell yet, queue is full
+         m_Dropped.fetch_add(1, std::memory_order_relaxed);
+         return false;
+      }
+      else
+      {
+         pos = m_EnqueuePos.load(std::memory_order_relaxed);
+      }
+   }
+
+   cell->cmd = cmd;
+   cell->cmd.postTime = std::chrono::steady_clock::now();
+   cell->seq.store(pos + 1, std::memory_order_release);
+
+   m_Posted.fetch_add(1, std::memory_order_relaxed);
+
+   // Track high-water mark
+   unsigned int depth = pos + 1 - m_DequeuePos.load(std::memory_order_relaxed);
+   unsigned int maxDepth = m_MaxDepth.load(std::memory_order_relaxed);
+   while ( (depth > maxDepth) &&
+           !m_MaxDepth.compare_exchange_weak(maxDepth, depth,
+                                             std::memory_order_relaxed) )
+   {
+   }
+
+   return true;
+}
+
+////////////////////////////////////////////////////////////////
+
+bool NolPiGuiCmdQueue::Empty() const
+{
+   return m_EnqueuePos.load(std::memory_order_relaxed) ==
+          m_DequeuePos.load(std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////
+
+NolPiGuiCmdQueue::Stats NolPiGuiCmdQueue::GetStats() const
+{
+   Stats stats;
+
+   stats.depth = m_EnqueuePos.load(std::memory_order_relaxed) -
+                 m_DequeuePos.load(std::memory_order_relaxed);
+   stats.maxDepth      = m_MaxDepth.load(std::memory_order_relaxed);
+   stats.posted        = m_Posted.load(std::memory_order_relaxed);
+   stats.drained       = m_Drained.load(std::memory_order_relaxed);
+   stats.dropped       = m_Dropped.load(std::memory_order_relaxed);
+   stats.batches       = m_Batches.load(std::memory_order_relaxed);
+   stats.lastLatencyUs = m_LastLatencyUs.load(std::memory_order_relaxed);
+   stats.maxLatencyUs  = m_MaxLatencyUs.load(std::memory_order_relaxed);
+   stats.avgLatencyUs  = 0;
+   if (stats.drained > 0)
+   {
+      stats.avgLatencyUs = static_cast<std::uint32_t>(
+         m_TotalLatencyUs.load(std::memory_order_relaxed) / stats.drained);
+   }
+
+   return stats;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//               Private member functions
+////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////
+
+bool NolPiGuiCmdQueue::Pop(NolPiGuiCmd &cmd)
+{
+   unsigned int pos = m_DequeuePos.load(std::memory_order_relaxed);
+   Cell *cell = &m_Cells[pos & (CAPACITY - 1)];
+   unsigned int seq = cell->seq.load(std::memory_order_acquire);
+
+   // Producer has not published this cell yet, queue is empty
+   if (static_cast<int>(seq - (pos + 1)) < 0)
+   {
+      return false;
+   }
+
+   cmd = cell->cmd;
+
+   // Release the cell for the producers one lap ahead
+   cell->seq.store(pos + CAPACITY, std::memory_order_release);
+   m_DequeuePos.store(pos + 1, std::memory_order_relaxed);
+
+   return true;
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiGuiCmdQueue::Account(const NolPiGuiCmd &cmd)
+{
+   auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - cmd.postTime).count();
+   std::uint32_t latencyUs = static_cast<std::uint32_t>(latency);
+
+   // Only the consumer updates these, no need for read-modify-write loops
+   m_Drained.fetch_add(1, std::memory_order_relaxed);
+   m_TotalLatencyUs.fetch_add(latencyUs, std::memory_order_relaxed);
+   m_LastLatencyUs.store(latencyUs, std::memory_order_relaxed);
+   if (latencyUs > m_MaxLatencyUs.load(std::memory_order_relaxed))
+   {
+      m_MaxLatencyUs.store(latencyUs, std::memory_order_relaxed);
+   }
+}
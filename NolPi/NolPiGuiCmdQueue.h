@@ -0,0 +1,105 @@
+#ifndef _NOLPI_GUI_CMD_QUEUE_H_
+#define _NOLPI_GUI_CMD_QUEUE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Command posted by a worker thread, executed by the LittlevGL task handler thread
+struct NolPiGuiCmd
+{
+   enum Type
+   {
+      TEMP_SAMPLES    // Temperature samples waiting in the ingest ring
+   };
+
+   Type      type{TEMP_SAMPLES};
+
+   // Set by the queue when posted
+   std::chrono::steady_clock::time_point postTime;
+};
+
+// Lock-free, bounded, multiple producer single consumer command queue.
+// Any thread may post, only the LittlevGL task handler thread may drain.
+class NolPiGuiCmdQueue
+{
+public:
+   static constexpr unsigned int CAPACITY = 256; // Must be a power of two
+
+   struct Stats
+   {
+      unsigned int  depth;         // Commands currently queued
+      unsigned int  maxDepth;      // Highest depth observed when posting
+      std::uint64_t posted;        // Commands successfully posted
+      std::uint64_t drained;       // Commands executed
+      std::uint64_t dropped;       // Commands rejected because queue was full
+      std::uint64_t batches;       // Number of non-empty drain batches
+      std::uint32_t lastLatencyUs; // Post -> execute latency of last command
+      std::uint32_t maxLatencyUs;  // Highest post -> execute latency
+      std::uint32_t avgLatencyUs;  // Average post -> execute latency
+   };
+
+   NolPiGuiCmdQueue();
+   ~NolPiGuiCmdQueue();
+
+   bool Post(const NolPiGuiCmd &cmd);
+
+   template <typename Executor>
+   unsigned int Drain(Executor execute, unsigned int maxBatch = CAPACITY);
+
+   bool Empty() const;
+
+   Stats GetStats() const;
+
+private:
+   struct Cell
+   {
+      std::atomic<unsigned int> seq;
+      NolPiGuiCmd               cmd;
+   };
+
+   Cell                      m_Cells[CAPACITY];
+   std::atomic<unsigned int> m_EnqueuePos{0};
+   std::atomic<unsigned int> m_DequeuePos{0}; // Written by consumer only
+
+   // Counters
+   std::atomic<unsigned int>  m_MaxDepth{0};
+   std::atomic<std::uint64_t> m_Posted{0};
+   std::atomic<std::uint64_t> m_Drained{0};
+   std::atomic<std::uint64_t> m_Dropped{0};
+   std::atomic<std::uint64_t> m_Batches{0};
+   std::atomic<std::uint64_t> m_TotalLatencyUs{0};
+   std::atomic<std::uint32_t> m_LastLatencyUs{0};
+   std::atomic<std::uint32_t> m_MaxLatencyUs{0};
+
+private:
+   bool Pop(NolPiGuiCmd &cmd);
+   void Account(const NolPiGuiCmd &cmd);
+};
+
+////////////////////////////////////////////////////////////////
+
+template <typename Executor>
+unsigned int NolPiGuiCmdQueue::Drain(Executor execute, unsigned int maxBatch)
+{
+   // Execute at most 'maxBatch' commands, so that a flood of posts
+   // can't starve the LittlevGL task handler.
+   unsigned int n = 0;
+   NolPiGuiCmd cmd;
+
+   while ( (n < maxBatch) && Pop(cmd) )
+   {
+      execute(cmd);
+      Account(cmd);
+      ++n;
+   }
+
+   if (n > 0)
+   {
+      m_Batches.fetch_add(1, std::memory_order_relaxed);
+   }
+
+   return n;
+}
+
+#endif // _NOLPI_GUI_CMD_QUEUE_H_
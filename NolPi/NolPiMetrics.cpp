@@ -0,0 +1,436 @@
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "NolPi/NolPiMetrics.h"
+
+////////////////////////////////////////////////////////////////////////////
+//               Global definitions
+////////////////////////////////////////////////////////////////////////////
+
+// Readers give up if the page keeps changing
+static constexpr int READ_RETRIES = 100;
+
+// Touches not followed by any flush within this time are not measured
+static constexpr std::chrono::milliseconds LATENCY_TIMEOUT{1000};
+
+////////////////////////////////////////////////////////////////////////////
+//               Public member functions
+////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+
+void NolPiHistogram::Add(std::uint32_t value)
+{
+   unsigned int idx = (value == 0 ? 0 : 32 - __builtin_clz(value));
+
+   buckets[idx]++;
+   count++;
+   sum += value;
+   max = (value > max ? value : max);
+}
+
+////////////////////////////////////////////////////////////////
+
+std::uint32_t NolPiHistogram::Average() const
+{
+   return (count > 0 ? static_cast<std::uint32_t>(sum / count) : 0);
+}
+
+////////////////////////////////////////////////////////////////
+
+std::uint32_t NolPiHistogram::Percentile(unsigned int pct) const
+{
+   std::uint64_t rank = (count * pct + 99) / 100;
+   std::uint64_t seen = 0;
+
+   for (unsigned int i=0; i < NR_BUCKETS; ++i)
+   {
+      seen += buckets[i];
+      if ( (seen >= rank) && (seen > 0) )
+      {
+         std::uint32_t upper = (i == 0 ? 0 : static_cast<std::uint32_t>((1ULL << i) - 1));
+         return (upper < max ? upper : max);
+      }
+   }
+
+   return max;
+}
+
+////////////////////////////////////////////////////////////////
+
+NolPiMetrics::NolPiMetrics()
+{
+}
+
+////////////////////////////////////////////////////////////////
+
+NolPiMetrics::~NolPiMetrics()
+{
+   if (m_pPage)
+   {
+      munmap(m_pPage, sizeof(NolPiMetricsPage));
+      shm_unlink(SHM_NAME);
+   }
+}
+
+////////////////////////////////////////////////////////////////
+
+bool NolPiMetrics::Open()
+{
+   m_pPage = MapPage(true);
+   if (m_pPage == nullptr)
+   {
+      return false;
+   }
+
+   memset(m_pPage, 0, sizeof(NolPiMetricsPage));
+   m_pPage->magic   = MAGIC;
+   m_pPage->version = VERSION;
+
+   return true;
+}
+
+////////////////////////////////////////////////////////////////
+
+void NolPiMetrics::FrameBegin()
+{
+   m_FrameStart = Clock::now();
+   m_FrameWaitTime = Clock::duration::zero();
+}
+
+////////////////////////////////////////////////////////////////
+
+void NolPiMetrics::FlushBegin()
+{
+   m_FlushStart = Clock::now();
+
+   if (m_TouchPending)
+   {
+      m_TouchPending = false;
+      if (m_FlushStart - m_TouchTime < LATENCY_TIMEOUT)
+      {
+         m_Stats.latencyUs.Add(ToUs(m_FlushStart - m_TouchTime));
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////
+
+void NolPiMetrics::FlushEnd()
+{
+   // With an asynchronous flush only the posting, the rest is in WaitBegin
+   m_FrameWaitTime += Clock::now() - m_FlushStart;
+}
+
+////////////////////////////////////////////////////////////////
+
+void NolPiMetrics::WaitBegin()
+{
+   m_WaitStart = Clock::now();
+}
+
+////////////////////////////////////////////////////////////////
+
+void NolPiMetrics::WaitEnd()
+{
+   m_FrameWaitTime += Clock::now() - m_WaitStart;
+}
+
+////////////////////////////////////////////////////////////////
+
+void NolPiMetrics::FlushReady()
+{
+   // m_FlushStart is written before flush_cb hands the area to this thread
+   std::int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      Clock::now() - m_FlushStart).count();
+   __atomic_fetch_add(&m_FlushNs, ns, __ATOMIC_RELAXED);
+}
+
+////////////////////////////////////////////////////////////////
+
+void NolPiMetrics::FrameEnd(std::uint32_t px, std::uint32_t merges,
+                            std::uint32_t drawPx, std::uint32_t cullPx,
+                            std::uint32_t late, std::uint32_t dropped)
+{
+   Clock::duration frameTime = Clock::now() - m_FrameStart;
+
+   // A flush still running now is counted in the next frame
+   std::chrono::nanoseconds flushTime(__atomic_exchange_n(&m_FlushNs, 0, __ATOMIC_RELAXED));
+
+   m_Stats.frames++;
+   m_Stats.merges = merges;
+   m_Stats.late = late;
+   m_Stats.dropped = dropped;
+   m_Stats.renderUs.Add(ToUs(frameTime - m_FrameWaitTime));
+   m_Stats.flushUs.Add(ToUs(flushTime));
+   m_Stats.pixels.Add(px);
+   if (px > 0)
+   {
+      m_Stats.overdraw.Add(static_cast<std::uint32_t>(
+         static_cast<std::uint64_t>(drawPx) * 100 / px));
+   }
+   m_Stats.culled.Add(cullPx);
+
+   Publish();
+}
+
+////////////////////////////////////////////////////////////////
+
+void NolPiMetrics::InputRead(bool pressed)
+{
+   // Both pressing and releasing may change the screen,
+   // the first of several touches before a flush is measured.
+   if ( (pressed != m_LastPressed) && !m_TouchPending )
+   {
+      m_TouchPending = true;
+      m_TouchTime = Clock::now();
+   }
+   m_LastPressed = pressed;
+}
+
+////////////////////////////////////////////////////////////////
+
+void NolPiMetrics::PreloadBegin()
+{
+   memset(&m_Stats.preload, 0, sizeof(m_Stats.preload));
+   m_PreloadStart = Clock::now();
+}
+
+////////////////////////////////////////////////////////////////
+
+void NolPiMetrics::PreloadStepBegin()
+{
+   m_PreloadStepStart = Clock::now();
+}
+
+////////////////////////////////////////////////////////////////
+
+void NolPiMetrics::PreloadStepEnd(const char *name)
+{
+   NolPiPreloadStats &preload = m_Stats.preload;
+   std::uint32_t time = ToUs(Clock::now() - m_PreloadStepStart);
+
+   if (preload.steps < NolPiPreloadStats::NR_STEPS)
+   {
+      snprintf(preload.names[preload.steps], NolPiPreloadStats::NAME_SIZE, "%s", name);
+      preload.stepUs[preload.steps] = time;
+   }
+   preload.steps++;
+}
+
+////////////////////////////////////////////////////////////////
+
+void NolPiMetrics::PreloadEnd()
+{
+   m_Stats.preload.totalUs = ToUs(Clock::now() - m_PreloadStart);
+}
+
+////////////////////////////////////////////////////////////////
+
+void NolPiMetrics::SetQueueStats(const NolPiGuiCmdQueue::Stats &cmdQueue,
+                                 const NolPiTempIngest::Stats &tempIngest)
+{
+   // Published with the next frame
+   m_Stats.cmdQueue = cmdQueue;
+   m_Stats.tempIngest = tempIngest;
+}
+
+////////////////////////////////////////////////////////////////
+
+const NolPiMetricsStats& NolPiMetrics::GetStats() const
+{
+   return m_Stats;
+}
+
+////////////////////////////////////////////////////////////////
+
+bool NolPiMetrics::OverlayRequested() const
+{
+   return m_pPage && (__atomic_load_n(&m_pPage->overlay, __ATOMIC_RELAXED) != 0);
+}
+
+////////////////////////////////////////////////////////////////
+
+bool NolPiMetrics::ReadPage(NolPiMetricsPage &page)
+{
+   NolPiMetricsPage *shared = MapPage(false);
+   if (shared == nullptr)
+   {
+      return false;
+   }
+
+   bool valid = false;
+   for (int i=0; (i < READ_RETRIES) && !valid; ++i)
+   {
+      std::uint32_t seq = __atomic_load_n(&shared->seq, __ATOMIC_ACQUIRE);
+      if (seq & 1)
+      {
+         usleep(100);
+         continue;
+      }
+      memcpy(&page, shared, sizeof(page));
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      valid = (__atomic_load_n(&shared->seq, __ATOMIC_RELAXED) == seq);
+   }
+
+   munmap(shared, sizeof(NolPiMetricsPage));
+
+   if ( valid && ((page.magic != MAGIC) || (page.version != VERSION)) )
+   {
+      printf("%s : %s has unknown format\n", __func__, SHM_NAME);
+      valid = false;
+   }
+
+   return valid;
+}
+
+////////////////////////////////////////////////////////////////
+
+bool NolPiMetrics::RequestOverlay(bool show)
+{
+   NolPiMetricsPage *shared = MapPage(false);
+   if (shared == nullptr)
+   {
+      return false;
+   }
+
+   __atomic_store_n(&shared->overlay, (show ? 1U : 0U), __ATOMIC_RELAXED);
+   munmap(shared, sizeof(NolPiMetricsPage));
+
+   return true;
+}
+
+////////////////////////////////////////////////////////////////
+
+void NolPiMetrics::PrintStats(const NolPiMetricsStats &stats)
+{
+   static const struct
+   {
+      const char                    *name;
+      const NolPiHistogram NolPiMetricsStats::*histogram;
+   } HISTOGRAMS[] =
+   {
+      {"render [us]",  &NolPiMetricsStats::renderUs},
+      {"flush [us]",   &NolPiMetricsStats::flushUs},
+      {"pixels",       &NolPiMetricsStats::pixels},
+      {"overdraw [%]", &NolPiMetricsStats::overdraw},
+      {"culled",       &NolPiMetricsStats::culled},
+      {"latency [us]", &NolPiMetricsStats::latencyUs},
+   };
+
+   printf("frames       : %llu\n", static_cast<unsigned long long>(stats.frames));
+   printf("area merges  : %llu\n", static_cast<unsigned long long>(stats.merges));
+   printf("late frames  : %llu\n", static_cast<unsigned long long>(stats.late));
+   printf("dropped      : %llu\n", static_cast<unsigned long long>(stats.dropped));
+   printf("%-12s   %8s %8s %8s %8s %8s %8s\n",
+          "", "count", "avg", "p50", "p95", "p99", "max");
+
+   for (const auto &h : HISTOGRAMS)
+   {
+      const NolPiHistogram &histogram = stats.*h.histogram;
+      printf("%-12s : %8llu %8u %8u %8u %8u %8u\n",
+             h.name,
+             static_cast<unsigned long long>(histogram.count),
+             histogram.Average(),
+             histogram.Percentile(50),
+             histogram.Percentile(95),
+             histogram.Percentile(99),
+             histogram.max);
+   }
+
+   const NolPiGuiCmdQueue::Stats &cmdQueue = stats.cmdQueue;
+   printf("cmd queue    : posted %llu drained %llu dropped %llu batches %llu depth %u max %u\n",
+          static_cast<unsigned long long>(cmdQueue.posted),
+          static_cast<unsigned long long>(cmdQueue.drained),
+          static_cast<unsigned long long>(cmdQueue.dropped),
+          static_cast<unsigned long long>(cmdQueue.batches),
+          cmdQueue.depth, cmdQueue.maxDepth);
+   printf("cmd latency  : last %u us avg %u us max %u us\n",
+          cmdQueue.lastLatencyUs, cmdQueue.avgLatencyUs, cmdQueue.maxLatencyUs);
+
+   const NolPiTempIngest::Stats &tempIngest = stats.tempIngest;
+   printf("temp ingest  : pushed %llu dropped %llu coalesced %llu batches %llu max depth %u\n",
+          static_cast<unsigned long long>(tempIngest.pushed),
+          static_cast<unsigned long long>(tempIngest.dropped),
+          static_cast<unsigned long long>(tempIngest.coalesced),
+          static_cast<unsigned long long>(tempIngest.batches),
+          tempIngest.maxDepth);
+
+   const NolPiPreloadStats &preload = stats.preload;
+   if (preload.totalUs > 0)
+   {
+      printf("preload [us] :");
+      for (unsigned int i=0; (i < preload.steps) && (i < NolPiPreloadStats::NR_STEPS); ++i)
+      {
+         printf(" %s %u", preload.names[i], preload.stepUs[i]);
+      }
+      printf(" total %u\n", preload.totalUs);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//               Private member functions
+////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////
+
+void NolPiMetrics::Publish()
+{
+   if (m_pPage == nullptr)
+   {
+      return;
+   }
+
+   // Sequence lock, readers retry if the sequence is odd or changed
+   std::uint32_t seq = m_pPage->seq;
+   __atomic_store_n(&m_pPage->seq, seq + 1, __ATOMIC_RELAXED);
+   __atomic_thread_fence(__ATOMIC_RELEASE);
+
+   memcpy(&m_pPage->stats, &m_Stats, sizeof(m_Stats));
+
+   __atomic_store_n(&m_pPage->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+///////////////////////////////////////////////////////////////
+
+NolPiMetricsPage* NolPiMetrics::MapPage(bool create)
+{
+   int fd = shm_open(SHM_NAME, (create ? O_RDWR | O_CREAT : O_RDWR), 0644);
+   if (fd == -1)
+   {
+      printf("%s : can't open shared memory %s\n", __func__, SHM_NAME);
+      return nullptr;
+   }
+
+   if ( create && (ftruncate(fd, sizeof(NolPiMetricsPage)) == -1) )
+   {
+      printf("%s : can't size shared memory %s\n", __func__, SHM_NAME);
+      close(fd);
+      return nullptr;
+   }
+
+   void *addr = mmap(NULL, sizeof(NolPiMetricsPage),
+                     PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   close(fd);
+
+   if (addr == MAP_FAILED)
+   {
+      printf("%s : can't map shared memory %s\n", __func__, SHM_NAME);
+      return nullptr;
+   }
+
+   return static_cast<NolPiMetricsPage *>(addr);
+}
+
+///////////////////////////////////////////////////////////////
+
+std::uint32_t NolPiMetrics::ToUs(Clock::duration duration)
+{
+   return static_cast<std::uint32_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
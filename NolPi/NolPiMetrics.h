@@ -0,0 +1,142 @@
+#ifndef _NOLPI_METRICS_H_
+#define _NOLPI_METRICS_H_
+
+#include <chrono>
+#include <cstdint>
+
+#include "NolPi/NolPiGuiCmdQueue.h"
+#include "NolPi/NolPiTempIngest.h"
+
+// Histogram with power of two buckets.
+// Bucket 0 counts the value 0, bucket i counts values in [2^(i-1), 2^i).
+struct NolPiHistogram
+{
+   static constexpr unsigned int NR_BUCKETS = 33;
+
+   std::uint64_t count;
+   std::uint64_t sum;
+   std::uint32_t max;
+   std::uint32_t buckets[NR_BUCKETS];
+
+   void Add(std::uint32_t value);
+
+   std::uint32_t Average() const;
+
+   // Upper bound of the bucket holding the percentile, at most 'max'
+   std::uint32_t Percentile(unsigned int pct) const;
+};
+
+// Time of the steps of the last preload
+struct NolPiPreloadStats
+{
+   static constexpr unsigned int NR_STEPS  = 4;
+   static constexpr unsigned int NAME_SIZE = 12;
+
+   std::uint32_t steps;                      // Steps run, at most NR_STEPS kept
+   char          names[NR_STEPS][NAME_SIZE];
+   std::uint32_t stepUs[NR_STEPS];
+   std::uint32_t totalUs;                    // Start -> main screen opened, 0 while running
+};
+
+// Statistics published in the shared memory page
+struct NolPiMetricsStats
+{
+   std::uint64_t  frames;    // Refreshes that flushed any pixels
+   std::uint64_t  merges;    // Dirty areas merged instead of redrawing all
+   std::uint64_t  late;      // Frames started over a refresh period after a change
+   std::uint64_t  dropped;   // Refresh periods without a frame while changed
+   NolPiHistogram renderUs;  // Time to render a frame, waiting for flushes excluded
+   NolPiHistogram flushUs;   // Time from flush_cb to lv_disp_flush_ready for a frame
+   NolPiHistogram pixels;    // Pixels refreshed in a frame
+   NolPiHistogram overdraw;  // Pixels drawn by objects per refreshed, in %
+   NolPiHistogram culled;    // Pixels not drawn in a frame, hidden by others
+   NolPiHistogram latencyUs; // Touch event -> first pixel flushed after it
+   NolPiPreloadStats preload;
+   NolPiGuiCmdQueue::Stats cmdQueue;   // Worker threads -> GUI commands
+   NolPiTempIngest::Stats  tempIngest; // Sensor samples -> chart batches
+};
+
+// Layout of the shared memory page
+struct NolPiMetricsPage
+{
+   std::uint32_t     magic;
+   std::uint32_t     version;
+   std::uint32_t     seq;     // Odd while the stats are written
+   std::uint32_t     overlay; // Set by readers, non zero shows the overlay
+   NolPiMetricsStats stats;
+};
+
+// Frame time and input latency metrics of the GUI.
+// Fed by the display and input driver callbacks in the LittlevGL task
+// handler thread, except FlushReady. The statistics are published each
+// frame in a shared memory page, readable by other processes without
+// disturbing the GUI.
+class NolPiMetrics
+{
+public:
+   static constexpr const char *SHM_NAME = "/nolpi-metrics";
+   static constexpr std::uint32_t MAGIC   = 0x4e504d53; // NPMS
+   static constexpr std::uint32_t VERSION = 6;
+
+   NolPiMetrics();
+   ~NolPiMetrics();
+
+   // Creates the shared memory page, metrics are collected anyway
+   bool Open();
+
+   // LittlevGL task handler thread only
+   void FrameBegin();
+   void FlushBegin();
+   void FlushEnd();
+   void WaitBegin();
+   void WaitEnd();
+   void FrameEnd(std::uint32_t px, std::uint32_t merges,
+                 std::uint32_t drawPx, std::uint32_t cullPx,
+                 std::uint32_t late, std::uint32_t dropped);
+   void InputRead(bool pressed);
+   void PreloadBegin();
+   void PreloadStepBegin();
+   void PreloadStepEnd(const char *name);
+   void PreloadEnd();
+   void SetQueueStats(const NolPiGuiCmdQueue::Stats &cmdQueue,
+                      const NolPiTempIngest::Stats &tempIngest);
+
+   // Thread calling lv_disp_flush_ready, may run concurrently with the others
+   void FlushReady();
+
+   const NolPiMetricsStats& GetStats() const;
+   bool OverlayRequested() const;
+
+   // Other processes. Copies a consistent snapshot of the shared page.
+   static bool ReadPage(NolPiMetricsPage &page);
+   static bool RequestOverlay(bool show);
+
+   static void PrintStats(const NolPiMetricsStats &stats);
+
+private:
+   using Clock = std::chrono::steady_clock;
+
+   NolPiMetricsStats  m_Stats{};
+   NolPiMetricsPage  *m_pPage{nullptr};
+
+   Clock::time_point m_FrameStart;
+   Clock::time_point m_FlushStart;
+   Clock::time_point m_WaitStart;
+   Clock::duration   m_FrameWaitTime{0}; // In flush_cb or wait_cb
+   std::int64_t      m_FlushNs{0};       // Flushed, atomic
+
+   bool              m_LastPressed{false};
+   bool              m_TouchPending{false};
+   Clock::time_point m_TouchTime;
+
+   Clock::time_point m_PreloadStart;
+   Clock::time_point m_PreloadStepStart;
+
+private:
+   void Publish();
+
+   static NolPiMetricsPage* MapPage(bool create);
+   static std::uint32_t ToUs(Clock::duration duration);
+};
+
+#endif // _NOLPI_METRICS_H_
@@ -0,0 +1,283 @@
+#include <cstring>
+
+#include "NolPi/NolPiSessionLog.h"
+
+////////////////////////////////////////////////////////////////////////////
+//               Global definitions
+////////////////////////////////////////////////////////////////////////////
+
+static const char MAGIC[4] = {'N', 'P', 'L', 'G'};
+
+static constexpr std::size_t HEADER_SIZE       = 8;
+static constexpr std::size_t RECORD_HEAD_SIZE  = 5; // time + type
+static constexpr std::size_t INPUT_RECORD_SIZE = RECORD_HEAD_SIZE + 5;
+static constexpr std::size_t TEMP_RECORD_SIZE  = RECORD_HEAD_SIZE + 2;
+
+static void PutU16(std::uint8_t *buf, std::uint16_t value)
+{
+   buf[0] = static_cast<std::uint8_t>(value);
+   buf[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+static void PutU32(std::uint8_t *buf, std::uint32_t value)
+{
+   PutU16(buf, static_cast<std::uint16_t>(value));
+   PutU16(buf + 2, static_cast<std::uint16_t>(value >> 16));
+}
+
+static std::uint16_t GetU16(const std::uint8_t *buf)
+{
+   return static_cast<std::uint16_t>(buf[0] | (buf[1] << 8));
+}
+
+static std::uint32_t GetU32(const std::uint8_t *buf)
+{
+   return GetU16(buf) | (static_cast<std::uint32_t>(GetU16(buf + 2)) << 16);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//               Public member functions
+////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+
+NolPiSessionLog::NolPiSessionLog(Mode mode, const std::string &path, double speed) :
+   m_Mode(mode),
+   m_Path(path),
+   m_Speed(speed > 0.0 ? speed : 1.0)
+{
+}
+
+////////////////////////////////////////////////////////////////
+
+NolPiSessionLog::~NolPiSessionLog()
+{
+   if (m_pFile)
+   {
+      fclose(m_pFile);
+   }
+}
+
+////////////////////////////////////////////////////////////////
+
+bool NolPiSessionLog::Open()
+{
+   if (m_Mode == Mode::REPLAY)
+   {
+      if (!Load())
+      {
+         return false;
+      }
+      printf("%s : replaying %zu input and %zu temperature events from %s\n",
+             __func__, m_InputEvents.size(), m_TempEvents.size(), m_Path.c_str());
+   }
+   else
+   {
+      m_pFile = fopen(m_Path.c_str(), "wb");
+      if (m_pFile == NULL)
+      {
+         printf("%s : can't create %s\n", __func__, m_Path.c_str());
+         return false;
+      }
+
+      std::uint8_t header[HEADER_SIZE];
+      memcpy(header, MAGIC, sizeof(MAGIC));
+      PutU32(header + 4, VERSION);
+      Write(header, sizeof(header));
+   }
+
+   m_Start = std::chrono::steady_clock::now();
+
+   return true;
+}
+
+////////////////////////////////////////////////////////////////
+
+bool NolPiSessionLog::Recording() const
+{
+   return m_Mode == Mode::RECORD;
+}
+
+////////////////////////////////////////////////////////////////
+
+bool NolPiSessionLog::Replaying() const
+{
+   return m_Mode == Mode::REPLAY;
+}
+
+////////////////////////////////////////////////////////////////
+
+void NolPiSessionLog::RecordInput(const lv_indev_data_t &data)
+{
+   InputEvent event{Now(), data.point.x, data.point.y, data.state};
+
+   // The input device is read periodically, only log changes
+   if ( m_HasLastInput &&
+        (event.x == m_LastInput.x) &&
+        (event.y == m_LastInput.y) &&
+        (event.state == m_LastInput.state) )
+   {
+      return;
+   }
+   m_LastInput = event;
+   m_HasLastInput = true;
+
+   std::uint8_t record[INPUT_RECORD_SIZE];
+   PutU32(record, event.time);
+   record[4] = RECORD_INPUT;
+   PutU16(record + 5, static_cast<std::uint16_t>(event.x));
+   PutU16(record + 7, static_cast<std::uint16_t>(event.y));
+   record[9] = event.state;
+   Write(record, sizeof(record));
+}
+
+////////////////////////////////////////////////////////////////
+
+void NolPiSessionLog::RecordTemp(int value)
+{
+   std::uint8_t record[TEMP_RECORD_SIZE];
+   PutU32(record, Now());
+   record[4] = RECORD_TEMP;
+   PutU16(record + 5, static_cast<std::uint16_t>(value));
+   Write(record, sizeof(record));
+}
+
+////////////////////////////////////////////////////////////////
+
+bool NolPiSessionLog::ReplayInput(lv_indev_data_t &data)
+{
+   std::uint32_t now = Now();
+
+   // Skip to the newest input that is due
+   while ( (m_InputIdx < m_InputEvents.size()) &&
+           (m_InputEvents[m_InputIdx].time <= now) )
+   {
+      m_LastInput = m_InputEvents[m_InputIdx++];
+   }
+
+   data.point.x = m_LastInput.x;
+   data.point.y = m_LastInput.y;
+   data.state   = m_LastInput.state;
+
+   return false; // No buffered input
+}
+
+////////////////////////////////////////////////////////////////
+
+bool NolPiSessionLog::InputDone() const
+{
+   return m_InputIdx >= m_InputEvents.size();
+}
+
+////////////////////////////////////////////////////////////////
+
+bool NolPiSessionLog::NextTemp(int &value, std::chrono::steady_clock::time_point &due)
+{
+   if (m_TempIdx >= m_TempEvents.size())
+   {
+      return false;
+   }
+
+   const TempEvent &event = m_TempEvents[m_TempIdx++];
+   value = event.value;
+   due = m_Start + std::chrono::microseconds(
+      static_cast<std::int64_t>(event.time * 1000.0 / m_Speed));
+
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//               Private member functions
+////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////
+
+bool NolPiSessionLog::Load()
+{
+   FILE *file = fopen(m_Path.c_str(), "rb");
+   if (file == NULL)
+   {
+      printf("%s : can't open %s\n", __func__, m_Path.c_str());
+      return false;
+   }
+
+   std::vector<std::uint8_t> buf;
+   std::uint8_t chunk[4096];
+   std::size_t len;
+   while ((len = fread(chunk, 1, sizeof(chunk), file)) > 0)
+   {
+      buf.insert(buf.end(), chunk, chunk + len);
+   }
+   fclose(file);
+
+   if ( (buf.size() < HEADER_SIZE) ||
+        (memcmp(buf.data(), MAGIC, sizeof(MAGIC)) != 0) ||
+        (GetU32(buf.data() + 4) != VERSION) )
+   {
+      printf("%s : %s is not a session log\n", __func__, m_Path.c_str());
+      return false;
+   }
+
+   std::size_t pos = HEADER_SIZE;
+   while (pos + RECORD_HEAD_SIZE <= buf.size())
+   {
+      const std::uint8_t *record = buf.data() + pos;
+      std::uint32_t time = GetU32(record);
+
+      if ( (record[4] == RECORD_INPUT) && (pos + INPUT_RECORD_SIZE <= buf.size()) )
+      {
+         InputEvent event;
+         event.time  = time;
+         event.x     = static_cast<std::int16_t>(GetU16(record + 5));
+         event.y     = static_cast<std::int16_t>(GetU16(record + 7));
+         event.state = record[9];
+         m_InputEvents.push_back(event);
+         pos += INPUT_RECORD_SIZE;
+      }
+      else if ( (record[4] == RECORD_TEMP) && (pos + TEMP_RECORD_SIZE <= buf.size()) )
+      {
+         TempEvent event;
+         event.time  = time;
+         event.value = static_cast<std::int16_t>(GetU16(record + 5));
+         m_TempEvents.push_back(event);
+         pos += TEMP_RECORD_SIZE;
+      }
+      else
+      {
+         // Truncated by an unclean exit while recording, keep what was read
+         printf("%s : %s is corrupt at offset %zu\n", __func__, m_Path.c_str(), pos);
+         break;
+      }
+   }
+
+   return true;
+}
+
+///////////////////////////////////////////////////////////////
+
+std::uint32_t NolPiSessionLog::Now() const
+{
+   auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - m_Start).count();
+
+   if (m_Mode == Mode::REPLAY)
+   {
+      elapsed = static_cast<decltype(elapsed)>(elapsed * m_Speed);
+   }
+
+   return static_cast<std::uint32_t>(elapsed);
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiSessionLog::Write(const std::uint8_t *buf, std::size_t len)
+{
+   std::lock_guard<std::mutex> lock(m_FileMutex);
+
+   if (m_pFile && (fwrite(buf, 1, len, m_pFile) != len))
+   {
+      printf("%s : can't write %s, recording stopped\n", __func__, m_Path.c_str());
+      fclose(m_pFile);
+      m_pFile = NULL;
+   }
+}
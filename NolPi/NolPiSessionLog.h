@@ -0,0 +1,103 @@
+#ifndef _NOLPI_SESSION_LOG_H_
+#define _NOLPI_SESSION_LOG_H_
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "LittlevGL/lvgl/lvgl.h"
+
+// Log of a user session, i.e. the input device reads and the temperature
+// samples with the time they occurred.
+// When recording, the GUI and the sensor thread add events to the log file.
+// When replaying, the log file is loaded and the events are fed back to the
+// GUI at the recorded time, optionally accelerated, instead of the live
+// input device and sensor.
+//
+// File format, all fields little endian:
+//   header: "NPLG" u32 version
+//   input : u32 time_ms, u8 type=1, i16 x, i16 y, u8 state
+//   temp  : u32 time_ms, u8 type=2, i16 value
+// Input is only logged when it differs from the previous read.
+class NolPiSessionLog
+{
+public:
+   enum class Mode
+   {
+      RECORD,
+      REPLAY
+   };
+
+   NolPiSessionLog(Mode mode, const std::string &path, double speed = 1.0);
+   ~NolPiSessionLog();
+
+   // Creates or loads the log file, the session time starts now
+   bool Open();
+
+   bool Recording() const;
+   bool Replaying() const;
+
+   // Record, input from the GUI thread and samples from the sensor thread
+   void RecordInput(const lv_indev_data_t &data);
+   void RecordTemp(int value);
+
+   // Replay input, GUI thread only.
+   // Reports the last input recorded before current session time.
+   bool ReplayInput(lv_indev_data_t &data);
+   bool InputDone() const;
+
+   // Replay samples, sensor thread only.
+   // Returns false when all samples are replayed.
+   bool NextTemp(int &value, std::chrono::steady_clock::time_point &due);
+
+private:
+   static constexpr std::uint32_t VERSION = 1;
+
+   enum RecordType : std::uint8_t
+   {
+      RECORD_INPUT = 1,
+      RECORD_TEMP  = 2
+   };
+
+   struct InputEvent
+   {
+      std::uint32_t time;
+      lv_coord_t    x;
+      lv_coord_t    y;
+      std::uint8_t  state;
+   };
+
+   struct TempEvent
+   {
+      std::uint32_t time;
+      int           value;
+   };
+
+   const Mode        m_Mode;
+   const std::string m_Path;
+   const double      m_Speed;
+
+   std::chrono::steady_clock::time_point m_Start;
+
+   // Recording, shared by the GUI and the sensor thread
+   std::mutex      m_FileMutex;
+   FILE           *m_pFile{nullptr};
+   InputEvent      m_LastInput{0, 0, 0, LV_INDEV_STATE_REL};
+   bool            m_HasLastInput{false};
+
+   // Replaying, each event list is used by one thread only
+   std::vector<InputEvent> m_InputEvents;
+   std::vector<TempEvent>  m_TempEvents;
+   std::size_t             m_InputIdx{0};
+   std::size_t             m_TempIdx{0};
+
+private:
+   bool Load();
+   std::uint32_t Now() const;
+   void Write(const std::uint8_t *buf, std::size_t len);
+};
+
+#endif // _NOLPI_SESSION_LOG_H_
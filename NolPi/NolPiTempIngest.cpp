@@ -0,0 +1,169 @@
+#include "NolPi/NolPiTempIngest.h"
+
+////////////////////////////////////////////////////////////////////////////
+//               Public member functions
+////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////
+
+NolPiTempIngest::NolPiTempIngest(unsigned int columnMs) :
+   m_ColumnPeriod(columnMs),
+   m_Epoch(std::chrono::steady_clock::now())
+{
+   static_assert((CAPACITY & (CAPACITY - 1)) == 0,
+                 "CAPACITY must be a power of two");
+}
+
+////////////////////////////////////////////////////////////////
+
+NolPiTempIngest::~NolPiTempIngest()
+{
+}
+
+////////////////////////////////////////////////////////////////
+
+bool NolPiTempIngest::Push(int value)
+{
+   unsigned int head = m_Head.load(std::memory_order_relaxed);
+   unsigned int tail = m_Tail.load(std::memory_order_acquire);
+   unsigned int depth = head - tail;
+
+   if (depth < CAPACITY)
+   {
+      NolPiTempSample &sample = m_Ring[head & (CAPACITY - 1)];
+      sample.time  = std::chrono::steady_clock::now();
+      sample.value = value;
+      m_Head.store(head + 1, std::memory_order_release);
+
+      m_Pushed.fetch_add(1, std::memory_order_relaxed);
+      if (depth + 1 > m_MaxDepth.load(std::memory_order_relaxed))
+      {
+         m_MaxDepth.store(depth + 1, std::memory_order_relaxed);
+      }
+   }
+   else
+   {
+      // Consumer is behind, drop the newest sample
+      m_Dropped.fetch_add(1, std::memory_order_relaxed);
+   }
+
+   // Pairs with the fence in Coalesce(), either the consumer sees the
+   // sample or this thread sees the ring disarmed and notifies.
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+
+   return !m_Armed.exchange(true, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////
+
+unsigned int NolPiTempIngest::Coalesce(Batch &batch)
+{
+   batch.samples = 0;
+   batch.min     = 0;
+   batch.max     = 0;
+   batch.last    = 0;
+   batch.columns.clear(); // Keeps capacity, no allocation in steady state
+
+   unsigned int n = DrainRing(batch);
+   if (n == 0)
+   {
+      // Ring is empty, next push must notify
+      m_Armed.store(false, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      // Samples pushed before the producer saw the ring disarmed
+      n = DrainRing(batch);
+      if (n > 0)
+      {
+         m_Armed.store(true, std::memory_order_relaxed);
+      }
+   }
+
+   if (n > 0)
+   {
+      m_Coalesced.fetch_add(n, std::memory_order_relaxed);
+      m_Batches.fetch_add(1, std::memory_order_relaxed);
+   }
+
+   return n;
+}
+
+////////////////////////////////////////////////////////////////
+
+NolPiTempIngest::Stats NolPiTempIngest::GetStats() const
+{
+   Stats stats;
+
+   stats.pushed    = m_Pushed.load(std::memory_order_relaxed);
+   stats.dropped   = m_Dropped.load(std::memory_order_relaxed);
+   stats.coalesced = m_Coalesced.load(std::memory_order_relaxed);
+   stats.batches   = m_Batches.load(std::memory_order_relaxed);
+   stats.maxDepth  = m_MaxDepth.load(std::memory_order_relaxed);
+
+   return stats;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//               Private member functions
+////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////
+
+unsigned int NolPiTempIngest::DrainRing(Batch &batch)
+{
+   unsigned int tail = m_Tail.load(std::memory_order_relaxed);
+   unsigned int head = m_Head.load(std::memory_order_acquire);
+
+   for (unsigned int pos = tail; pos != head; ++pos)
+   {
+      Add(batch, m_Ring[pos & (CAPACITY - 1)]);
+   }
+
+   // Release the drained samples to the producer
+   m_Tail.store(head, std::memory_order_release);
+
+   return head - tail;
+}
+
+///////////////////////////////////////////////////////////////
+
+void NolPiTempIngest::Add(Batch &batch, const NolPiTempSample &sample)
+{
+   const int value = sample.value;
+   const std::uint32_t index =
+      static_cast<std::uint32_t>((sample.time - m_Epoch) / m_ColumnPeriod);
+
+   if ( (!m_HasCurrent) || (index != m_Current.index) )
+   {
+      // Start a new column
+      m_Current.index   = index;
+      m_Current.min     = value;
+      m_Current.max     = value;
+      m_Current.last    = value;
+      m_Current.samples = 0;
+      m_HasCurrent = true;
+      batch.columns.push_back(m_Current);
+   }
+   else if (batch.columns.empty())
+   {
+      // Continue the column opened by a previous batch
+      batch.columns.push_back(m_Current);
+   }
+
+   Column &column = batch.columns.back();
+   column.min  = (value < column.min ? value : column.min);
+   column.max  = (value > column.max ? value : column.max);
+   column.last = value;
+   column.samples++;
+   m_Current = column;
+
+   if (batch.samples == 0)
+   {
+      batch.min = value;
+      batch.max = value;
+   }
+   batch.min  = (value < batch.min ? value : batch.min);
+   batch.max  = (value > batch.max ? value : batch.max);
+   batch.last = value;
+   batch.samples++;
+}
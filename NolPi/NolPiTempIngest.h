@@ -0,0 +1,94 @@
+#ifndef _NOLPI_TEMP_INGEST_H_
+#define _NOLPI_TEMP_INGEST_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Timestamped temperature sample
+struct NolPiTempSample
+{
+   std::chrono::steady_clock::time_point time;
+   int                                   value{0};
+};
+
+// Ingestion stage between a temperature sensor and the GUI.
+// The sensor thread pushes samples at its own rate into a lock-free ring.
+// The LittlevGL task handler thread coalesces everything pushed since the
+// previous frame into one batch, so widgets are updated once per frame
+// instead of once per sample.
+// Samples are grouped in columns of fixed length in time, one column for
+// each point of the temperature chart.
+class NolPiTempIngest
+{
+public:
+   static constexpr unsigned int CAPACITY = 1024; // Must be a power of two
+
+   struct Column
+   {
+      std::uint32_t index;   // Column number, counted from ingest creation
+      int           min;     // Lowest sample in column
+      int           max;     // Highest sample in column
+      int           last;    // Newest sample in column
+      unsigned int  samples; // Number of samples in column
+   };
+
+   struct Batch
+   {
+      unsigned int        samples; // Samples coalesced in this batch
+      int                 min;     // Lowest sample in this batch
+      int                 max;     // Highest sample in this batch
+      int                 last;    // Newest sample
+      std::vector<Column> columns; // Columns touched, oldest first.
+                                   // The last one is still open and
+                                   // may be continued by next batch.
+   };
+
+   struct Stats
+   {
+      std::uint64_t pushed;    // Samples pushed by the sensor
+      std::uint64_t dropped;   // Samples rejected because ring was full
+      std::uint64_t coalesced; // Samples coalesced into batches
+      std::uint64_t batches;   // Number of non-empty batches
+      unsigned int  maxDepth;  // Highest number of samples waiting in ring
+   };
+
+   explicit NolPiTempIngest(unsigned int columnMs);
+   ~NolPiTempIngest();
+
+   // Single producer. Returns true if the consumer must be notified,
+   // i.e. this is the first sample since the consumer found the ring empty.
+   bool Push(int value);
+
+   // Consumer only. Returns number of samples coalesced into 'batch'.
+   unsigned int Coalesce(Batch &batch);
+
+   Stats GetStats() const;
+
+private:
+   const std::chrono::milliseconds             m_ColumnPeriod;
+   const std::chrono::steady_clock::time_point m_Epoch;
+
+   NolPiTempSample           m_Ring[CAPACITY];
+   std::atomic<unsigned int> m_Head{0}; // Written by producer only
+   std::atomic<unsigned int> m_Tail{0}; // Written by consumer only
+   std::atomic<bool>         m_Armed{false};
+
+   // Column currently being filled, consumer only
+   Column m_Current{};
+   bool   m_HasCurrent{false};
+
+   // Counters
+   std::atomic<std::uint64_t> m_Pushed{0};
+   std::atomic<std::uint64_t> m_Dropped{0};
+   std::atomic<std::uint64_t> m_Coalesced{0};
+   std::atomic<std::uint64_t> m_Batches{0};
+   std::atomic<unsigned int>  m_MaxDepth{0};
+
+private:
+   unsigned int DrainRing(Batch &batch);
+   void Add(Batch &batch, const NolPiTempSample &sample);
+};
+
+#endif // _NOLPI_TEMP_INGEST_H_
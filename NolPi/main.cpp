@@ -1,22 +1,86 @@
 #include <iostream>
-#include <future>
+#include <memory>
+#include <csignal>
+#include <cstdlib>
+#include <unistd.h>
 
 #include "NolPi/NolPi.h"
+#include "NolPi/NolPiSessionLog.h"
 #include "LittlevGL/lvgl/src/lv_version.h"
- 
+
+static void Usage(const char *prog)
+{
+   std::cerr << "Usage: " << prog << " [-r session.log | -p session.log [-s speed]]" << std::endl
+             << "  -r  record input and temperature to the log" << std::endl
+             << "  -p  replay input and temperature from the log" << std::endl
+             << "  -s  replay speed, e.g. 2 for twice as fast" << std::endl;
+}
+
 int main(int argc, char *argv[])
 {
-   (void)argc;
-   (void)argv;
+   const char *recordPath = nullptr;
+   const char *replayPath = nullptr;
+   double speed = 1.0;
+
+   int opt;
+   while ((opt = getopt(argc, argv, "r:p:s:")) != -1)
+   {
+      switch (opt)
+      {
+      case 'r':
+         recordPath = optarg;
+         break;
+      case 'p':
+         replayPath = optarg;
+         break;
+      case 's':
+         speed = std::atof(optarg);
+         break;
+      default:
+         Usage(argv[0]);
+         return 1;
+      }
+   }
+   if ( (recordPath && replayPath) || (speed <= 0.0) )
+   {
+      Usage(argv[0]);
+      return 1;
+   }
 
    std::cout << "NolPi demo, LittlevGL:"
              << LVGL_VERSION_MAJOR << "."
              << LVGL_VERSION_MINOR << "."
              << LVGL_VERSION_PATCH << std::endl;
 
-   NolPi app;
+   std::unique_ptr<NolPiSessionLog> log;
+   if (recordPath)
+   {
+      log.reset(new NolPiSessionLog(NolPiSessionLog::Mode::RECORD, recordPath));
+   }
+   else if (replayPath)
+   {
+      log.reset(new NolPiSessionLog(NolPiSessionLog::Mode::REPLAY, replayPath, speed));
+   }
+   if ( log && !log->Open() )
+   {
+      return 1;
+   }
+
+   // Handled by this thread only, blocked before any other thread is created
+   sigset_t sigs;
+   sigemptyset(&sigs);
+   sigaddset(&sigs, SIGINT);
+   sigaddset(&sigs, SIGTERM);
+   pthread_sigmask(SIG_BLOCK, &sigs, NULL);
+
+   {
+      NolPi app(log.get());
 
-   std::promise<void>().get_future().wait();
+      // Run until terminated, then shut down cleanly to restore the console
+      // and complete the session log.
+      int sig;
+      sigwait(&sigs, &sig);
+   }
 
    return 0;
 }
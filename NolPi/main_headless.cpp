@@ -0,0 +1,153 @@
+#include <iostream>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "NolPi/NolPi.h"
+#include "NolPi/NolPiSessionLog.h"
+#include "NolPi/NolPiMetrics.h"
+#include "LittlevGL/lvgl/src/lv_version.h"
+#include "LittlevGL/lv_drivers/display/headless.h"
+#include "LittlevGL/lv_drivers/indev/touch_script.h"
+
+// Benchmark of the NolPi screens, rendered into memory.
+// The screens are navigated by a touch script, or by a replayed session.
+
+#define CLICK(t, x, y) {(t), (x), (y), true}, {(t) + 100, (x), (y), false}
+
+// Visits all screens, coordinates of the buttons in the 480x320 screens
+static const touch_script_point_t SCRIPT[] =
+{
+   CLICK( 500, 240,  85), // Entry screen, simulate checkbox
+   CLICK(1000, 240, 160), // Entry screen, start button
+   CLICK(3000, 450,  22), // Main screen, next button
+   CLICK(5000, 450,  22), // Chart screen, next button
+   CLICK(8000,  30,  22), // Image screen, prev button
+   CLICK(9000,  30,  22), // Chart screen, prev button
+};
+
+static void Usage(const char *prog)
+{
+   std::cerr << "Usage: " << prog
+             << " [-r session.log | -p session.log [-s speed]] [seconds] [frame.ppm]"
+             << std::endl
+             << "  -r  record the touch script and temperature to the log" << std::endl
+             << "  -p  replay input and temperature from the log" << std::endl
+             << "  -s  replay speed, e.g. 2 for twice as fast" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+   const char *recordPath = nullptr;
+   const char *replayPath = nullptr;
+   double speed = 1.0;
+
+   int opt;
+   while ((opt = getopt(argc, argv, "r:p:s:")) != -1)
+   {
+      switch (opt)
+      {
+      case 'r':
+         recordPath = optarg;
+         break;
+      case 'p':
+         replayPath = optarg;
+         break;
+      case 's':
+         speed = std::atof(optarg);
+         break;
+      default:
+         Usage(argv[0]);
+         return 1;
+      }
+   }
+
+   int seconds = (optind < argc ? std::atoi(argv[optind]) : 10);
+   const char *ppmPath = (optind + 1 < argc ? argv[optind + 1] : nullptr);
+
+   if ( (seconds <= 0) || (recordPath && replayPath) || (speed <= 0.0) )
+   {
+      Usage(argv[0]);
+      return 1;
+   }
+
+   std::cout << "NolPi headless benchmark, LittlevGL:"
+             << LVGL_VERSION_MAJOR << "."
+             << LVGL_VERSION_MINOR << "."
+             << LVGL_VERSION_PATCH << std::endl;
+
+   touch_script_set(SCRIPT, sizeof(SCRIPT) / sizeof(SCRIPT[0]));
+
+   std::unique_ptr<NolPiSessionLog> log;
+   if (recordPath)
+   {
+      log.reset(new NolPiSessionLog(NolPiSessionLog::Mode::RECORD, recordPath));
+   }
+   else if (replayPath)
+   {
+      log.reset(new NolPiSessionLog(NolPiSessionLog::Mode::REPLAY, replayPath, speed));
+   }
+   if ( log && !log->Open() )
+   {
+      return 1;
+   }
+
+   NolPiMetricsPage metrics;
+   bool hasMetrics;
+
+   auto start = std::chrono::steady_clock::now();
+   {
+      NolPi app(log.get());
+      std::this_thread::sleep_for(std::chrono::seconds(seconds));
+
+      // Published while the application runs
+      hasMetrics = NolPiMetrics::ReadPage(metrics);
+   }
+   std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+
+   headless_stats_t stats;
+   headless_get_stats(&stats);
+
+   double avgMs = (stats.frames > 0 ?
+                   static_cast<double>(stats.time_sum) / stats.frames : 0.0);
+
+   std::cout << "frames     : " << stats.frames << std::endl
+             << "fps        : " << stats.frames / wall.count() << std::endl
+             << "render fps : " << (avgMs > 0.0 ? 1000.0 / avgMs : 0.0)
+             << " (render bound)" << std::endl
+             << "frame avg  : " << avgMs << " ms" << std::endl
+             << "frame max  : " << stats.time_max << " ms" << std::endl
+             << "flushes    : " << stats.flushes << std::endl
+             << "copies     : " << stats.copies << std::endl
+             << "pixels     : " << stats.px << std::endl
+             << "flushed px : " << stats.flush_px << std::endl;
+
+   if (hasMetrics)
+   {
+      std::cout << std::endl;
+      NolPiMetrics::PrintStats(metrics.stats);
+      std::cout << std::endl;
+   }
+
+   if ( log && log->Replaying() )
+   {
+      if (!log->InputDone())
+      {
+         std::cout << "note       : session not completed" << std::endl;
+      }
+   }
+   else if (!touch_script_done())
+   {
+      std::cout << "note       : touch script not completed" << std::endl;
+   }
+
+   if ( (ppmPath != nullptr) && !headless_dump_ppm(ppmPath) )
+   {
+      std::cerr << "Can't write " << ppmPath << std::endl;
+      return 1;
+   }
+
+   return 0;
+}
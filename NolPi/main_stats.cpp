@@ -0,0 +1,67 @@
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+#include "NolPi/NolPiMetrics.h"
+
+// Reads the metrics published by a running NolPi.
+// Usage: nolpi-stats.exe [-o on|off] [-w seconds]
+
+static void Usage(const char *prog)
+{
+   std::cerr << "Usage: " << prog << " [-o on|off] [-w seconds]" << std::endl
+             << "  -o  show or hide the metrics overlay on the display" << std::endl
+             << "  -w  print the metrics repeatedly, with this interval" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+   const char *overlay = nullptr;
+   int interval = 0;
+
+   int opt;
+   while ((opt = getopt(argc, argv, "o:w:")) != -1)
+   {
+      switch (opt)
+      {
+      case 'o':
+         overlay = optarg;
+         break;
+      case 'w':
+         interval = std::atoi(optarg);
+         break;
+      default:
+         Usage(argv[0]);
+         return 1;
+      }
+   }
+
+   if (overlay)
+   {
+      bool show = (strcmp(overlay, "on") == 0);
+      if ( (!show && (strcmp(overlay, "off") != 0)) ||
+           !NolPiMetrics::RequestOverlay(show) )
+      {
+         return 1;
+      }
+   }
+
+   do
+   {
+      NolPiMetricsPage page;
+      if (!NolPiMetrics::ReadPage(page))
+      {
+         return 1;
+      }
+      NolPiMetrics::PrintStats(page.stats);
+
+      if (interval > 0)
+      {
+         std::cout << std::endl;
+         sleep(interval);
+      }
+   } while (interval > 0);
+
+   return 0;
+}